@@ -0,0 +1,155 @@
+#include "core/arena.h"
+#include "core/pathfinding.h"
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * 网格排列的基准：在1000×1000和4000×4000的网格上比较行优先、Z序和分块排列。
+ *
+ *   泛洪    棋盘上没有食物，find_nearest_food_path遍历全部可达格子
+ *   A*      find_path_to从棋盘中央的蛇头走到左上角
+ *   竞技场  占用网格块内使用各排列，随机转向的蛇同时步进，
+ *           存活的蛇少于一半时补充
+ *
+ * 每项重复若干次，取最短的一次。
+ * 用法：grid-layout-bench [重复次数]
+ */
+
+// 默认重复次数
+#define BENCH_DEFAULT_REPEAT 5
+// 蛇的长度
+#define BENCH_SNAKE_LENGTH 3
+// 竞技场中每条蛇平均占有的格子数
+#define BENCH_ARENA_CELLS_PER_SNAKE 200
+// 竞技场每次计时的步数
+#define BENCH_ARENA_TICKS 50
+
+static const int benchSizes[] = {1000, 4000};
+static const GridLayoutKind benchLayouts[] = {
+    GRID_LAYOUT_ROW_MAJOR,
+    GRID_LAYOUT_MORTON,
+    GRID_LAYOUT_TILED,
+};
+
+static inline double elapsed_ms(Uint64 start) {
+  return (double)(SDL_GetTicksNS() - start) / 1e6;
+}
+
+// 泛洪和A*，结果写入floodMs和searchMs；路径长度不同时返回false
+static bool bench_path_finder(int size, GridLayoutKind layout, int repeat,
+                              double *floodMs, double *searchMs,
+                              int *pathLength) {
+  PathFinder finder;
+  Snake snake;
+  FoodManager foods;
+  init_path_finder(&finder, size, size, layout);
+  init_snake(&snake, size / 2, size / 2, BENCH_SNAKE_LENGTH);
+  init_food_manager(&foods, 1);
+
+  *floodMs = -1.0;
+  *searchMs = -1.0;
+  bool consistent = true;
+  for (int i = 0; i < repeat; i++) {
+    Uint64 start = SDL_GetTicksNS();
+    find_nearest_food_path(&finder, &snake, &foods);
+    double ms = elapsed_ms(start);
+    if (*floodMs < 0.0 || ms < *floodMs) {
+      *floodMs = ms;
+    }
+
+    start = SDL_GetTicksNS();
+    int length = find_path_to(&finder, &snake, 0, 0);
+    ms = elapsed_ms(start);
+    if (*searchMs < 0.0 || ms < *searchMs) {
+      *searchMs = ms;
+    }
+    consistent = consistent && (i == 0 || length == *pathLength);
+    *pathLength = length;
+  }
+
+  cleanup_food_manager(&foods);
+  cleanup_snake(&snake);
+  cleanup_path_finder(&finder);
+  return consistent;
+}
+
+// 竞技场步进，返回平均每步的毫秒数（各次中最短的）
+static double bench_arena(int size, GridLayoutKind layout, int repeat) {
+  const int snakes = size / BENCH_ARENA_CELLS_PER_SNAKE * size;
+  GameConfig config = {0};
+  config.gridWidth = size;
+  config.gridHeight = size;
+  config.initialSnakeLength = BENCH_SNAKE_LENGTH;
+  config.maxFoodCount = snakes / 4;
+
+  Arena arena;
+  init_arena(&arena, &config, layout, 1);
+  for (int i = 0; i < snakes; i++) {
+    spawn_arena_snake(&arena);
+  }
+
+  double best = -1.0;
+  uint64_t rng = 1;
+  for (int i = 0; i < repeat; i++) {
+    Uint64 total = 0;
+    for (int tick = 0; tick < BENCH_ARENA_TICKS; tick++) {
+      for (int k = 0; k < arena.aliveCount; k++) {
+        uint32_t random = next_food_random(&rng);
+        if ((random & 3) == 0) {
+          steer_arena_snake(&arena, arena.alive[k],
+                            (Direction)((random >> 2) & 3));
+        }
+      }
+      Uint64 start = SDL_GetTicksNS();
+      step_arena(&arena);
+      total += SDL_GetTicksNS() - start;
+      while (arena.aliveCount < snakes / 2 && spawn_arena_snake(&arena) >= 0) {
+      }
+    }
+    double ms = (double)total / 1e6 / BENCH_ARENA_TICKS;
+    if (best < 0.0 || ms < best) {
+      best = ms;
+    }
+  }
+  cleanup_arena(&arena);
+  return best;
+}
+
+int main(int argc, char **argv) {
+  int repeat = argc > 1 ? atoi(argv[1]) : BENCH_DEFAULT_REPEAT;
+  if (repeat < 1) {
+    repeat = 1;
+  }
+
+  printf("%-10s %-10s %12s %12s %14s\n", "size", "layout", "flood(ms)",
+         "A*(ms)", "arena(ms/tick)");
+  bool consistent = true;
+  for (size_t s = 0; s < sizeof(benchSizes) / sizeof(benchSizes[0]); s++) {
+    const int size = benchSizes[s];
+    int expectedLength = 0;
+    for (size_t l = 0; l < sizeof(benchLayouts) / sizeof(benchLayouts[0]);
+         l++) {
+      double floodMs, searchMs;
+      int pathLength = 0;
+      consistent &= bench_path_finder(size, benchLayouts[l], repeat, &floodMs,
+                                      &searchMs, &pathLength);
+      // 各排列的最短路径长度必须相同
+      consistent &= l == 0 || pathLength == expectedLength;
+      expectedLength = pathLength;
+      double arenaMs = bench_arena(size, benchLayouts[l], repeat);
+
+      char label[32];
+      snprintf(label, sizeof(label), "%dx%d", size, size);
+      printf("%-10s %-10s %12.2f %12.2f %14.3f\n", label,
+             get_grid_layout_name(benchLayouts[l]), floodMs, searchMs,
+             arenaMs);
+    }
+  }
+
+  if (!consistent) {
+    fprintf(stderr, "各排列的路径长度不一致\n");
+    return 1;
+  }
+  return 0;
+}
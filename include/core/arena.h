@@ -0,0 +1,244 @@
+#pragma once
+
+#include "core/sparse_grid.h"
+#include "core/state.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * 多蛇竞技场：大量蛇共享一张网格和一份食物。
+ *
+ * 网格每格记录占用者（空、食物或蛇的编号），碰撞和生成食物只查所在格子，
+ * 与蛇身长度无关。网格是稀疏分块的（sparse_grid.h），内存与蛇和食物覆盖的
+ * 区域成正比，超大网格上只有少量蛇时也不会按网格尺寸分配。蛇身是格子的
+ * 环形缓冲，每步只写入新蛇头、擦除旧蛇尾，因此每步的开销与蛇的数量成正比，
+ * 而不是与蛇身总长成正比。
+ *
+ * 每步分两个阶段：
+ *   提议  各蛇按方向算出新蛇头，撞墙或撞到蛇身（含蛇尾，与move_snake相同）
+ *         的蛇标记死亡，目标格子只读取步进前的网格
+ *   裁决  多个蛇头进入同一格子时最长的蛇存活，一样长则全部死亡；
+ *         之后移除死亡的蛇并移动存活的蛇
+ * 裁决只依赖步进前的局面而不依赖处理顺序，结果是确定的。
+ * 蛇头进入食物格子时立即得分，与step_game一样下一步才增长（蛇尾不动）。
+ */
+
+// 格子内容：ARENA_CELL_EMPTY、ARENA_CELL_FOOD，或蛇的编号 + 1
+#define ARENA_CELL_EMPTY 0u
+#define ARENA_CELL_FOOD UINT32_MAX
+
+// 死亡原因
+typedef enum {
+  ARENA_DEATH_NONE,    // 存活
+  ARENA_DEATH_WALL,    // 撞墙
+  ARENA_DEATH_BODY,    // 撞到蛇身（自己或其他蛇）
+  ARENA_DEATH_HEAD_ON, // 迎头相撞且不是唯一最长的蛇
+} ArenaDeath;
+
+// 网格坐标
+typedef struct {
+  int x; // 网格X坐标
+  int y; // 网格Y坐标
+} ArenaCell;
+
+// 竞技场中的一条蛇
+typedef struct {
+  ArenaCell *body;         // 蛇身环形缓冲，容量为2的幂，死亡后释放为NULL
+  int capacity;            // 环形缓冲容量
+  int head;                // 蛇头在环形缓冲中的下标，蛇身向后依次排列
+  int length;              // 蛇的长度
+  Direction direction;     // 当前方向
+  Direction nextDirection; // 下一步的方向，反向在步进时被忽略
+  bool grow;               // 上一步吃到食物，这一步蛇尾不动
+  ArenaDeath death;        // 死亡原因，存活时为ARENA_DEATH_NONE
+  int score;               // 得分
+} ArenaSnake;
+
+// 一条蛇在当前步的提议
+typedef struct {
+  int snake;        // 蛇的编号
+  int length;       // 步进前的长度，迎头相撞时比较
+  ArenaCell target; // 新蛇头
+  bool eats;        // 新蛇头处是否有食物
+  ArenaDeath death; // 提议阶段判定的死亡原因
+} ArenaMove;
+
+// 迎头相撞检测用的散列表条目，按目标格子记录最长的蛇
+typedef struct {
+  uint64_t key; // 格子下标 + 1，0表示空条目
+  int best;     // 最长的蛇的编号
+  int length;   // 最长的蛇的长度
+  bool tied;    // 是否有多条蛇一样长
+} ArenaClaim;
+
+// 迎头相撞散列表（开放寻址），登记结果与登记顺序无关
+typedef struct {
+  ArenaClaim *entries; // 条目
+  int capacity;        // 容量（2的幂），至少为登记数的两倍
+} ArenaClaimTable;
+
+// 竞技场
+typedef struct {
+  GameConfig config;      // 网格尺寸、初始长度和最大食物数
+  SparseGrid cells;       // 占用网格（稀疏分块）
+  ArenaSnake *snakes;     // 按编号存放的蛇，死亡的蛇只保留得分和死亡原因
+  int snakeCount;         // 蛇的数量（含死亡的）
+  int snakeCapacity;      // snakes的容量
+  int *alive;             // 存活的蛇的编号（按加入顺序），容量为snakeCapacity
+  int aliveCount;         // 存活的蛇数，即alive的长度
+  int foodCount;          // 食物数量
+  uint64_t rngState;      // 食物和出生位置的随机数状态
+  unsigned int tickCount; // 已执行的步数
+  ArenaMove *moves;       // 当前步的提议，容量为snakeCapacity
+  ArenaClaimTable claims; // 迎头相撞散列表
+} Arena;
+
+static inline size_t arena_cell_index(const Arena *arena, int x, int y) {
+  return (size_t)y * (size_t)arena->config.gridWidth + (size_t)x;
+}
+
+static inline bool arena_in_bounds(const Arena *arena, int x, int y) {
+  return x >= 0 && x < arena->config.gridWidth && y >= 0 &&
+         y < arena->config.gridHeight;
+}
+
+/**
+ * @brief 读取格子内容
+ * @param arena 竞技场指针
+ * @param x 网格X坐标（必须在网格内）
+ * @param y 网格Y坐标（必须在网格内）
+ * @return ARENA_CELL_EMPTY、ARENA_CELL_FOOD或蛇的编号 + 1
+ */
+static inline uint32_t get_arena_cell(const Arena *arena, int x, int y) {
+  return get_sparse_cell(&arena->cells, x, y);
+}
+
+/**
+ * @brief 蛇头位置
+ * @param snake 存活的蛇的指针
+ * @return 蛇头格子
+ */
+static inline ArenaCell get_arena_snake_head(const ArenaSnake *snake) {
+  return snake->body[snake->head];
+}
+
+/**
+ * @brief 初始化竞技场并生成食物
+ * @param arena 竞技场指针
+ * @param config 游戏配置（使用网格尺寸、初始长度和最大食物数）
+ * @param layout 占用网格块内格子的排列方式，不影响步进的结果
+ * @param seed 随机数种子，相同种子和相同输入得到相同结果
+ */
+void init_arena(Arena *arena, const GameConfig *config, GridLayoutKind layout,
+                uint64_t seed);
+
+/**
+ * @brief 释放竞技场资源
+ * @param arena 竞技场指针
+ */
+void cleanup_arena(Arena *arena);
+
+/**
+ * @brief 在指定位置放置一条蛇，蛇身从蛇头向方向的反方向伸展
+ * @param arena 竞技场指针
+ * @param x 蛇头X坐标
+ * @param y 蛇头Y坐标
+ * @param direction 初始方向
+ * @param length 长度
+ * @return 蛇的编号；蛇身超出网格或压到蛇、食物时返回-1。
+ *         添加蛇可能使之前取得的ArenaSnake指针失效
+ */
+int add_arena_snake(Arena *arena, int x, int y, Direction direction,
+                    int length);
+
+/**
+ * @brief 在随机的空位放置一条初始长度的蛇
+ * @param arena 竞技场指针
+ * @return 蛇的编号；多次尝试都找不到空位时返回-1
+ */
+int spawn_arena_snake(Arena *arena);
+
+/**
+ * @brief 设置蛇下一步的方向
+ * @param arena 竞技场指针
+ * @param id 蛇的编号
+ * @param direction 方向，与当前方向相反时在步进时被忽略
+ */
+void steer_arena_snake(Arena *arena, int id, Direction direction);
+
+/**
+ * @brief 所有存活的蛇同时前进一步，然后补充食物
+ * @param arena 竞技场指针
+ * @return 这一步死亡的蛇数
+ */
+int step_arena(Arena *arena);
+
+// ---------------- 步进的各个步骤 ----------------
+// step_arena由以下步骤依次组成。分块并行步进（arena_parallel.h）在多个线程中
+// 调用它们，各步骤只读写所给的蛇和格子，不修改竞技场的计数
+
+/**
+ * @brief 提议阶段：应用下一步的方向并判定撞墙和撞到蛇身，只读取网格
+ * @param arena 竞技场指针
+ * @param id 存活的蛇的编号
+ * @param move 输出的提议
+ */
+void propose_arena_move(Arena *arena, int id, ArenaMove *move);
+
+/**
+ * @brief 清空散列表，容量不足登记数的两倍时扩大
+ * @param table 散列表指针
+ * @param count 将要登记的提议数
+ */
+void reset_arena_claims(ArenaClaimTable *table, int count);
+
+/**
+ * @brief 释放散列表
+ * @param table 散列表指针
+ */
+void cleanup_arena_claims(ArenaClaimTable *table);
+
+/**
+ * @brief 登记一个未死亡的提议
+ * @param table 散列表指针
+ * @param arena 竞技场指针
+ * @param move 提议
+ */
+void claim_arena_target(ArenaClaimTable *table, const Arena *arena,
+                        const ArenaMove *move);
+
+/**
+ * @brief 所有提议登记完后，判定一个提议是否独占目标格子
+ * @param table 散列表指针
+ * @param arena 竞技场指针
+ * @param move 已登记的提议
+ * @return 是唯一最长的蛇时返回true
+ */
+bool wins_arena_claim(const ArenaClaimTable *table, const Arena *arena,
+                      const ArenaMove *move);
+
+/**
+ * @brief 执行裁决后的提议：死亡的蛇从网格上移除，存活的蛇前进一步
+ *
+ * 不同的蛇写入的格子互不重叠，可在多个线程中同时对不同的蛇调用，
+ * 此前须用reserve_sparse_chunks为每个提议预留一个分块。死亡的蛇释放蛇身。
+ * 不修改存活列表和foodCount，由调用方汇总。
+ *
+ * @param arena 竞技场指针
+ * @param move 提议，death为最终的死亡原因
+ * @return 吃到食物时返回true
+ */
+bool apply_arena_move(Arena *arena, const ArenaMove *move);
+
+/**
+ * @brief 从存活列表中移除这一步死亡的蛇，并更新aliveCount
+ * @param arena 竞技场指针
+ */
+void prune_arena_snakes(Arena *arena);
+
+/**
+ * @brief 补充食物到最大数量，使用竞技场的随机数，只能在单个线程中调用
+ * @param arena 竞技场指针
+ */
+void replenish_arena_food(Arena *arena);
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "core/arena.h"
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+
+// 默认分块边长（格子数，2的幂）
+#define ARENA_DEFAULT_TILE_SIZE 64
+
+typedef struct ArenaTile ArenaTile;
+typedef struct ArenaWorker ArenaWorker;
+
+// 多线程步进的阶段
+typedef enum {
+  ARENA_PHASE_PROPOSE, // 各分块为蛇头在块内的蛇提议
+  ARENA_PHASE_RESOLVE, // 各分块裁决目标在块内的提议并执行
+  ARENA_PHASE_QUIT,    // 工作线程退出
+} ArenaPhase;
+
+/**
+ * @brief 按分块并行步进竞技场
+ *
+ * 网格划分为边长tileSize的分块，每条蛇归属于蛇头所在的分块。每步分两个并行
+ * 阶段，阶段之间由调用线程汇合：
+ *   提议  各分块只读网格，为块内的蛇调用propose_arena_move；目标落在其他
+ *         分块的提议放入出站列表
+ *   合并  调用线程按分块顺序把出站提议转交给目标所在的分块（只有靠近边界的
+ *         少数蛇），跨边界的冲突因此与块内冲突在同一张散列表中裁决
+ *   裁决  各分块为目标在块内的提议登记、判定迎头相撞并调用apply_arena_move，
+ *         存活的蛇归入新蛇头所在的本分块
+ * 最后由调用线程汇总计数并补充食物。裁决与登记顺序无关，各蛇写入的格子互不
+ * 重叠，食物只在单线程中生成，因此结果与线程数和调度无关，与step_arena相同。
+ */
+typedef struct {
+  Arena *arena;           // 竞技场，步进期间不能由其他线程修改
+  int threadCount;        // 线程数（包含调用线程）
+  int tileShift;          // 分块边长的以2为底的对数
+  int tilesX;             // 水平方向的分块数
+  int tilesY;             // 垂直方向的分块数
+  ArenaTile *tiles;       // 按行优先存放的分块
+  int knownSnakes;        // 已归入分块的蛇数（编号小于它的蛇）
+  unsigned int knownTick; // 分块列表对应的竞技场步数
+  ArenaPhase phase;       // 工作线程当前执行的阶段
+  SDL_AtomicInt nextTile; // 下一个待领取的分块
+  SDL_Semaphore *done;    // 工作线程完成一个阶段时发出信号
+  ArenaWorker *workers;   // 常驻工作线程（不含调用线程）
+  int workerCount;        // 成功创建的工作线程数
+} ArenaStepper;
+
+/**
+ * @brief 初始化并启动常驻工作线程
+ * @param stepper 步进器指针
+ * @param arena 竞技场指针
+ * @param threadCount 线程数（包含调用线程），小于1时使用逻辑核心数
+ * @param tileSize 分块边长，向上取整到2的幂
+ */
+void init_arena_stepper(ArenaStepper *stepper, Arena *arena, int threadCount,
+                        int tileSize);
+
+/**
+ * @brief 停止工作线程并释放资源
+ * @param stepper 步进器指针
+ */
+void cleanup_arena_stepper(ArenaStepper *stepper);
+
+/**
+ * @brief 多线程步进一步，结果与step_arena相同
+ *
+ * 上次步进后新加入的蛇会自动归入分块；期间调用过step_arena时重建全部分块。
+ *
+ * @param stepper 步进器指针
+ * @return 这一步死亡的蛇数
+ */
+int step_arena_parallel(ArenaStepper *stepper);
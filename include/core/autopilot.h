@@ -0,0 +1,52 @@
+#pragma once
+
+#include "core/game.h"
+#include <stdbool.h>
+
+/**
+ * @brief 哈密顿回路自动驾驶：沿一条经过每个格子恰好一次的回路行驶，可一直吃到棋盘填满
+ *
+ * 蛇身各节在回路上的序号从蛇尾到蛇头依次递增（按回路方向），只要保持这一顺序，
+ * 沿回路前进就不会撞到自己。在顺序不被破坏且给增长留有余量时，允许跳到回路上
+ * 更靠前的相邻格子（捷径），以更快地到达食物。
+ */
+typedef struct {
+  int gridWidth;  // 网格宽度
+  int gridHeight; // 网格高度
+  int cellCount;  // 格子数
+  int *cells;     // 回路上第i个格子的下标（y * gridWidth + x）
+  int *order;     // 每个格子在回路上的序号
+} HamiltonAutopilot;
+
+/**
+ * @brief 初始化自动驾驶：优先从缓存目录读取回路，没有或无效时生成并写回缓存
+ * @param pilot 自动驾驶指针
+ * @param gridWidth 网格宽度
+ * @param gridHeight 网格高度
+ * @param cacheDirectory 缓存目录（按尺寸区分文件），NULL表示不使用缓存
+ * @return 成功返回true；宽高都为奇数或小于2时不存在回路，返回false
+ */
+bool init_hamilton_autopilot(HamiltonAutopilot *pilot, int gridWidth,
+                             int gridHeight, const char *cacheDirectory);
+
+/**
+ * @brief 释放自动驾驶的回路
+ * @param pilot 自动驾驶指针
+ */
+void cleanup_hamilton_autopilot(HamiltonAutopilot *pilot);
+
+/**
+ * @brief 每局开始后调用：选择与蛇身顺序一致的回路方向
+ * @param pilot 自动驾驶指针
+ * @param game 游戏指针
+ * @return 蛇身能沿回路的某个方向排列、且回路的下一格不在当前方向正后方时
+ *         返回true，否则返回false（无法驾驶这一局）
+ */
+bool sync_hamilton_autopilot(HamiltonAutopilot *pilot, const Game *game);
+
+/**
+ * @brief 计算下一步的方向并通过change_direction设置，每次逻辑步进前调用一次
+ * @param pilot 自动驾驶指针
+ * @param game 游戏指针
+ */
+void drive_hamilton_autopilot(const HamiltonAutopilot *pilot, Game *game);
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "core/game.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// 位棋盘的最大宽度和高度：每行压缩在一个64位字中
+#define BITBOARD_MAX_SIZE 64
+
+/**
+ * @brief 位棋盘：第y行的第x位表示格子(x, y)
+ *
+ * 泛洪填充只用移位、与、或和加法按整行推进，不逐格访问。
+ */
+typedef struct {
+  int width;                        // 网格宽度
+  int height;                       // 网格高度
+  uint64_t rows[BITBOARD_MAX_SIZE]; // 每行一个字，低位在前
+} Bitboard;
+
+// 单个候选移动的安全性
+typedef struct {
+  int area; // 移动后从蛇头可到达的空格数，移动致死时为-1
+  bool cut; // 移动后是否有空格与蛇头不连通（致死时为true）
+} MoveSafety;
+
+static inline void bitboard_set(Bitboard *board, int x, int y) {
+  board->rows[y] |= 1ULL << x;
+}
+
+static inline bool bitboard_test(const Bitboard *board, int x, int y) {
+  return (board->rows[y] >> x) & 1;
+}
+
+/**
+ * @brief 初始化为空棋盘
+ * @param board 位棋盘指针
+ * @param width 网格宽度
+ * @param height 网格高度
+ * @return 成功返回true，尺寸超过BITBOARD_MAX_SIZE时返回false
+ */
+bool init_bitboard(Bitboard *board, int width, int height);
+
+/**
+ * @brief 由蛇身生成可通行格子的位棋盘，与check_snake_collision使用相同的占用
+ * @param board 输出的位棋盘
+ * @param config 游戏配置
+ * @param snake 蛇指针
+ * @return 成功返回true，网格过大时返回false
+ */
+bool build_free_bitboard(Bitboard *board, const GameConfig *config,
+                         const Snake *snake);
+
+/**
+ * @brief 统计置位的格子数
+ * @param board 位棋盘指针
+ * @return 格子数
+ */
+int bitboard_count(const Bitboard *board);
+
+/**
+ * @brief 从region中的格子出发，在open内泛洪填充，结果写回region
+ * @param open 可通行格子
+ * @param region 输入为起点（必须在open内），输出为可到达的全部格子
+ */
+void bitboard_flood_fill(const Bitboard *open, Bitboard *region);
+
+/**
+ * @brief 从(x, y)出发在open内可到达的格子数（含起点）
+ * @param open 可通行格子
+ * @param x 起点X坐标
+ * @param y 起点Y坐标
+ * @return 格子数，起点不可通行时返回0
+ */
+int bitboard_reachable_area(const Bitboard *open, int x, int y);
+
+/**
+ * @brief 同时评估四个方向的移动：是否致死、移动后的可达面积以及是否切断空间
+ * @param game 游戏指针
+ * @param safety 输出，按Direction下标存放
+ * @return 成功返回true，网格过大或蛇为空时返回false
+ */
+bool evaluate_move_safety(const Game *game, MoveSafety safety[4]);
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * 运行时指令集分发：同一个二进制在不同的CPU上选用各自最快的SIMD内核。
+ *
+ * 启动时用cpuid（以及xgetbv确认操作系统保存了YMM/ZMM寄存器）检测一次CPU
+ * 特性。每个内核族把各指令集的实现列成一张变体表，第一次使用时由
+ * select_cpu_kernels选出一个并绑定到函数指针，之后不再检测。
+ *
+ * 各指令集的实现放在单独的编译单元中（文件名以指令集结尾），由
+ * src/CMakeLists.txt只对这些文件加上-mavx2等选项；编译器不支持或不是x86时
+ * 这些单元导出NULL，对应的变体被跳过，标量实现总是可用。
+ *
+ * 目前按CPU分发的有两个内核族：策略网络的矩阵乘（policy_kernels*.c，
+ * SSE2/SSE4.2/AVX2/AVX-512）和网格排列的编码解码（grid_layout_bmi2.c，
+ * BMI2的pdep/pext）。其他用到位运算或SIMD的地方都只依赖x86-64的基线：
+ * 传感器的ctz/clz已排除0，编译为bsf/bsr；位棋盘的popcount在没有-mpopcnt时
+ * 是软件实现，但每次泛洪只按行调用一次，不在热循环中；软件光栅器只用SSE2。
+ * 以后的内核族需要更高的指令集时，照这两处的方式拆出编译单元并列出变体表。
+ *
+ * 调试时可以强制使用较低的指令集：windows.ini的[debug] simd，或环境变量
+ * CPU_DISPATCH_ENV（优先）。可选值为auto、scalar、sse2、sse4.2、avx2、avx512，
+ * 只能在CPU支持的范围内降低，不能强制启用CPU不支持的特性。
+ */
+
+// 强制指定指令集的环境变量
+#define CPU_DISPATCH_ENV "SNAKE_SIMD"
+
+// CPU特性，按位组合
+typedef enum {
+  CPU_FEATURE_SSE2 = 1u << 0,   // SSE2（x86-64的基线）
+  CPU_FEATURE_SSE42 = 1u << 1,  // SSE4.2（含SSE4.1、SSSE3）
+  CPU_FEATURE_AVX2 = 1u << 2,   // AVX2，且操作系统保存YMM寄存器
+  CPU_FEATURE_AVX512 = 1u << 3, // AVX-512 F/BW/VL，且操作系统保存ZMM寄存器
+  CPU_FEATURE_BMI2 = 1u << 4,   // BMI2（pdep/pext），用于网格排列的编码解码
+} CpuFeature;
+
+// 内核族的一个变体
+typedef struct {
+  const char *name;    // 名称，用于日志
+  uint32_t required;   // 需要的CPU特性
+  const void *kernels; // 该变体的内核表，未编译时为NULL
+} CpuKernelVariant;
+
+/**
+ * @brief 确定生效的CPU特性，只有第一次调用有效
+ *
+ * 没有调用时，第一次使用内核时按环境变量自动初始化。
+ *
+ * @param level 配置文件中指定的指令集，NULL或空串表示auto；环境变量优先
+ */
+void init_cpu_dispatch(const char *level);
+
+/**
+ * @brief 检测CPU支持的特性，不受强制指定的影响
+ * @return CpuFeature的组合
+ */
+uint32_t detect_cpu_features(void);
+
+/**
+ * @brief 生效的CPU特性，需要时先初始化，可在多个线程中调用
+ * @return CpuFeature的组合
+ */
+uint32_t get_cpu_features(void);
+
+/**
+ * @brief 选出第一个已编译且CPU支持的变体
+ * @param family 内核族的名称，用于日志
+ * @param variants 变体表，按优先顺序排列，最后一项应当无需任何特性
+ * @param count 变体数
+ * @return 选中变体的内核表，全都不可用时为NULL
+ */
+const void *select_cpu_kernels(const char *family,
+                               const CpuKernelVariant *variants, int count);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stdint.h>
 #include "utils/knode.h"
 
 // 食物结构体
@@ -16,6 +17,8 @@ typedef struct {
     KNode head;         // 食物链表头节点
     int count;          // 当前食物数量
     int maxCount;       // 最大食物数量
+    uint64_t rngState;  // 随机数状态（每个管理器独立，互不干扰）
+    uint64_t hash;      // 所有食物格子的Zobrist哈希（增量维护）
 } FoodManager;
 
 /**
@@ -25,6 +28,20 @@ typedef struct {
  */
 void init_food_manager(FoodManager* manager, int maxCount);
 
+/**
+ * @brief 设置食物位置的随机数种子（相同种子生成相同的食物序列）
+ * @param manager 食物管理器指针
+ * @param seed 随机数种子
+ */
+void seed_food_manager(FoodManager* manager, uint64_t seed);
+
+/**
+ * @brief 食物位置使用的随机数（splitmix64），搜索中复制的局面用它复现食物生成
+ * @param rngState 随机数状态
+ * @return 32位随机数
+ */
+uint32_t next_food_random(uint64_t* rngState);
+
 /**
  * @brief 清理食物管理器资源
  * @param manager 食物管理器指针
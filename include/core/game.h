@@ -0,0 +1,76 @@
+#pragma once
+
+#include "core/food.h"
+#include "core/snake.h"
+#include "core/state.h"
+#include "utils/fsm.h"
+
+// 游戏命令（由输入事件设置，在下一次状态机更新时由转换条件消费）
+typedef enum {
+  GAME_COMMAND_NONE = 0,
+  GAME_COMMAND_ACTION = 1 << 0,  // 确认：菜单中开始游戏，游戏中暂停/继续
+  GAME_COMMAND_RESTART = 1 << 1, // 重新开始：游戏结束后回到菜单
+} GameCommand;
+
+// 游戏结构体，组合状态、蛇、食物和驱动它们的状态机
+typedef struct {
+  GameStateData state;     // 游戏状态
+  Snake snake;             // 贪吃蛇
+  FoodManager foodManager; // 食物管理器
+  FSM fsm;                 // 游戏流程状态机
+  unsigned int commands;   // 待处理的命令位掩码
+} Game;
+
+/**
+ * @brief 初始化游戏并进入菜单状态
+ * @param game 游戏指针
+ * @param config 游戏配置
+ */
+void init_game(Game *game, const GameConfig *config);
+
+/**
+ * @brief 清理游戏资源
+ * @param game 游戏指针
+ */
+void cleanup_game(Game *game);
+
+/**
+ * @brief 更新游戏（处理命令、状态转换并执行当前状态的逻辑）
+ * @param game 游戏指针
+ * @param deltaTime 时间增量（秒）
+ */
+void update_game(Game *game, float deltaTime);
+
+/**
+ * @brief 发送游戏命令
+ * @param game 游戏指针
+ * @param command 命令
+ */
+void send_game_command(Game *game, GameCommand command);
+
+/**
+ * @brief 执行一次逻辑步进（吃食物、移动蛇、补充食物）
+ * @param game 游戏指针
+ * @return 蛇是否仍然存活
+ */
+bool step_game(Game *game);
+
+/**
+ * @brief 重新生成蛇和食物，恢复到开局布局
+ * @param game 游戏指针
+ */
+void reset_game_board(Game *game);
+
+/**
+ * @brief 局面的Zobrist哈希（蛇头、蛇身各节的连接、食物、当前方向和得分），O(1)
+ * @param game 游戏指针
+ * @return 64位哈希
+ */
+uint64_t game_hash(const Game *game);
+
+/**
+ * @brief 遍历整个局面重新计算哈希，用于校验增量维护的结果
+ * @param game 游戏指针
+ * @return 64位哈希，与game_hash一致
+ */
+uint64_t compute_game_hash(const Game *game);
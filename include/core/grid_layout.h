@@ -0,0 +1,181 @@
+#pragma once
+
+#include "core/state.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * 网格格子在一维数组中的排列方式。
+ *
+ * 行优先时上下相邻的格子相隔一整行，大网格上寻路、泛洪填充等按邻域扩展的
+ * 访问几乎每次都落在不同的缓存行。Z序（Morton序）把x和y的各位交错排列，
+ * 2^k × 2^k的方块总是连续存放，上下左右的邻居大多在同一缓存行或同一页内。
+ *
+ * 非行优先的排列把坐标的每一位放到下标的固定位置上：下标 = x的各位散布到
+ * xMask + y的各位散布到yMask。编码和解码由init_grid_layout通过
+ * select_cpu_kernels选择：CPU支持BMI2时用pdep/pext（grid_layout_bmi2.c，
+ * 单独以-mbmi2编译），否则用移位和掩码交错，两者结果相同。
+ * 邻居直接在下标上做掩码加减，无需解码。
+ *
+ *   GRID_LAYOUT_MORTON  两轴各向上取整到2的幂，较短一轴的位数全部交错，较长
+ *                       一轴多出的高位接在最上面；长宽比大时不会膨胀到正方形
+ *   GRID_LAYOUT_TILED   8×8的小块（块内Z序，64格）按行排列，每行的块数
+ *                       向上取整到2的幂，只在x方向有填充
+ */
+
+// 分块排列中小块边长的以2为底的对数
+#define GRID_TILE_SHIFT 3
+
+// 排列方式
+typedef enum {
+  GRID_LAYOUT_ROW_MAJOR, // 行优先
+  GRID_LAYOUT_MORTON,    // Z序
+  GRID_LAYOUT_TILED,     // 8×8小块按行排列，块内Z序
+} GridLayoutKind;
+
+typedef struct GridLayout GridLayout;
+
+// 非行优先排列的编码和解码
+typedef struct {
+  uint32_t (*encode)(const GridLayout *layout, uint32_t x, uint32_t y);
+  void (*decode)(const GridLayout *layout, uint32_t index, int *x, int *y);
+} GridLayoutCodec;
+
+extern const GridLayoutCodec *const gridLayoutCodecPortable; // 总是可用
+extern const GridLayoutCodec *const gridLayoutCodecBmi2;     // CPU_FEATURE_BMI2
+
+// 排列的参数，由init_grid_layout计算
+struct GridLayout {
+  GridLayoutKind kind;          // 排列方式
+  int width;                    // 网格宽度
+  int height;                   // 网格高度
+  int lowBits;                  // x和y低位交错的位数
+  int xHighShift;               // x剩余高位在下标中的起始位置
+  int yHighShift;               // y剩余高位在下标中的起始位置
+  uint32_t xMask;               // x的各位在下标中的位置（行优先时不用）
+  uint32_t yMask;               // y的各位在下标中的位置，与xMask合起来是全部的位
+  size_t cellCount;             // 下标范围，可能大于width * height
+  const GridLayoutCodec *codec; // 编码和解码（行优先时不用）
+};
+
+// 把低16位依次放到偶数位上
+static inline uint32_t spread_grid_bits(uint32_t value) {
+  value &= 0xFFFFu;
+  value = (value | (value << 8)) & 0x00FF00FFu;
+  value = (value | (value << 4)) & 0x0F0F0F0Fu;
+  value = (value | (value << 2)) & 0x33333333u;
+  value = (value | (value << 1)) & 0x55555555u;
+  return value;
+}
+
+// spread_grid_bits的逆运算：取出偶数位，压缩到低16位
+static inline uint32_t compact_grid_bits(uint32_t value) {
+  value &= 0x55555555u;
+  value = (value | (value >> 1)) & 0x33333333u;
+  value = (value | (value >> 2)) & 0x0F0F0F0Fu;
+  value = (value | (value >> 4)) & 0x00FF00FFu;
+  value = (value | (value >> 8)) & 0x0000FFFFu;
+  return value;
+}
+
+/**
+ * @brief 不使用BMI2的编码，init_grid_layout也用它计算掩码
+ * @param layout 排列指针（非行优先）
+ * @param x X坐标
+ * @param y Y坐标
+ * @return 下标
+ */
+static inline uint32_t encode_grid_cell_portable(const GridLayout *layout,
+                                                 uint32_t x, uint32_t y) {
+  const uint32_t low = (1u << layout->lowBits) - 1;
+  return spread_grid_bits(x & low) | (spread_grid_bits(y & low) << 1) |
+         ((x >> layout->lowBits) << layout->xHighShift) |
+         ((y >> layout->lowBits) << layout->yHighShift);
+}
+
+/**
+ * @brief 格子的下标
+ * @param layout 排列指针
+ * @param x X坐标（必须在网格内）
+ * @param y Y坐标（必须在网格内）
+ * @return 下标，小于cellCount
+ */
+static inline uint32_t get_grid_cell_index(const GridLayout *layout, int x,
+                                           int y) {
+  if (layout->kind == GRID_LAYOUT_ROW_MAJOR) {
+    return (uint32_t)y * (uint32_t)layout->width + (uint32_t)x;
+  }
+  return layout->codec->encode(layout, (uint32_t)x, (uint32_t)y);
+}
+
+/**
+ * @brief 由下标求格子坐标
+ * @param layout 排列指针
+ * @param index 格子的下标
+ * @param x 输出的X坐标
+ * @param y 输出的Y坐标
+ */
+static inline void get_grid_cell_coords(const GridLayout *layout,
+                                        uint32_t index, int *x, int *y) {
+  if (layout->kind == GRID_LAYOUT_ROW_MAJOR) {
+    *x = (int)(index % (uint32_t)layout->width);
+    *y = (int)(index / (uint32_t)layout->width);
+    return;
+  }
+  layout->codec->decode(layout, index, x, y);
+}
+
+/**
+ * @brief 相邻格子的下标，不做边界检查
+ *
+ * 非行优先时把另一轴的位全部置1（加）或清0（减），进位和借位便只在本轴的
+ * 位之间传递。越过网格边缘时结果无意义，调用方需保证邻居在网格内。
+ *
+ * @param layout 排列指针
+ * @param index 格子的下标
+ * @param direction 方向
+ * @return 邻居的下标
+ */
+static inline uint32_t step_grid_cell(const GridLayout *layout, uint32_t index,
+                                      Direction direction) {
+  if (layout->kind == GRID_LAYOUT_ROW_MAJOR) {
+    switch (direction) {
+    case DIRECTION_UP:
+      return index - (uint32_t)layout->width;
+    case DIRECTION_DOWN:
+      return index + (uint32_t)layout->width;
+    case DIRECTION_LEFT:
+      return index - 1;
+    default:
+      return index + 1;
+    }
+  }
+
+  const uint32_t mask = direction == DIRECTION_UP || direction == DIRECTION_DOWN
+                            ? layout->yMask
+                            : layout->xMask;
+  const uint32_t moved = direction == DIRECTION_DOWN ||
+                                 direction == DIRECTION_RIGHT
+                             ? (index | ~mask) + 1
+                             : (index & mask) - 1;
+  return (moved & mask) | (index & ~mask);
+}
+
+/**
+ * @brief 计算排列的参数
+ * @param layout 排列指针
+ * @param kind 排列方式
+ * @param width 网格宽度
+ * @param height 网格高度
+ * @return 成功返回true，下标超出32位时返回false
+ */
+bool init_grid_layout(GridLayout *layout, GridLayoutKind kind, int width,
+                      int height);
+
+/**
+ * @brief 排列方式的名称，用于日志
+ * @param kind 排列方式
+ * @return 名称
+ */
+const char *get_grid_layout_name(GridLayoutKind kind);
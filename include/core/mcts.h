@@ -0,0 +1,98 @@
+#pragma once
+
+#include "core/game.h"
+#include "core/search_state.h"
+#include "core/transposition.h"
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// 搜索树的最大深度（从根节点开始的选择步数）
+#define MCTS_MAX_DEPTH 128
+// 节点价值的定点缩放（一次模拟的价值在0到MCTS_VALUE_SCALE之间）
+#define MCTS_VALUE_SCALE 1024
+
+// 模拟（rollout）策略
+typedef enum {
+  MCTS_ROLLOUT_RANDOM,    // 在三个非反向方向中均匀随机
+  MCTS_ROLLOUT_HEURISTIC, // 避开立即致死的方向，并偏向最近的食物
+} MctsRolloutPolicy;
+
+// 搜索配置
+typedef struct {
+  int threadCount;          // 搜索线程数（包含调用线程）
+  int nodeCapacity;         // 节点池容量，用完后不再扩展
+  int iterations;           // 每次搜索的迭代次数
+  int rolloutDepth;         // 每次模拟的最大步数
+  float exploration;        // UCT探索系数
+  MctsRolloutPolicy policy; // 模拟策略
+  uint64_t seed;            // 各线程随机数的种子
+  int tableMegabytes;       // 置换表大小（MB），0表示不使用置换表
+} MctsConfig;
+
+// 搜索结果与吞吐量统计
+typedef struct {
+  Direction bestMove;       // 访问次数最多的方向
+  int iterations;           // 完成的迭代（模拟）次数
+  int nodes;                // 使用的节点数
+  double seconds;           // 搜索耗时（秒）
+  double nodesPerSecond;    // 每秒扩展的节点数
+  double rolloutsPerSecond; // 每秒完成的模拟次数
+  TranspositionStats table; // 置换表统计（各线程之和）
+} MctsResult;
+
+/**
+ * @brief 树节点，所有字段都可被多个线程同时访问
+ *
+ * 选择时先增加visits（虚拟损失：价值要到回传时才加上，正在被其他线程探索的
+ * 分支暂时显得更差），使各线程分散到不同分支。
+ */
+typedef struct {
+  SDL_AtomicInt visits;   // 访问次数（包含未完成的虚拟损失）
+  SDL_AtomicInt value;    // 价值之和（定点，见MCTS_VALUE_SCALE）
+  SDL_AtomicInt children; // 0未扩展，-1正在扩展，否则为3个连续子节点中第一个的下标
+  Direction action;       // 从父节点到达此节点的方向
+} MctsNode;
+
+typedef struct MctsWorker MctsWorker;
+
+// 多线程蒙特卡洛树搜索
+typedef struct {
+  MctsConfig config;        // 搜索配置
+  MctsNode *nodes;          // 预分配的节点池
+  SDL_AtomicInt nodeCount;  // 已使用的节点数
+  SDL_AtomicInt issued;     // 已分配出去的迭代次数
+  SearchState root;         // 根局面，搜索期间只读
+  TranspositionTable table; // 各线程共享的置换表，跨搜索保留
+  MctsWorker *workers;      // 各线程的工作区（局面副本、路径、随机数）
+  SDL_Semaphore *done;      // 常驻线程完成一次搜索时发出信号
+  bool quit;                // 为true时常驻线程被唤醒后退出
+} MctsPlayer;
+
+/**
+ * @brief 默认搜索配置
+ * @return 配置
+ */
+MctsConfig mcts_default_config(void);
+
+/**
+ * @brief 初始化搜索，预分配节点池和各线程的工作区，并启动常驻搜索线程
+ * @param player 搜索指针
+ * @param config 搜索配置
+ */
+void init_mcts_player(MctsPlayer *player, const MctsConfig *config);
+
+/**
+ * @brief 停止常驻搜索线程并释放搜索资源
+ * @param player 搜索指针
+ */
+void cleanup_mcts_player(MctsPlayer *player);
+
+/**
+ * @brief 从当前局面搜索下一步的方向
+ * @param player 搜索指针
+ * @param game 游戏指针
+ * @param result 输出的搜索结果
+ * @return 成功返回true；局面超出SearchState的上限时返回false
+ */
+bool mcts_search(MctsPlayer *player, const Game *game, MctsResult *result);
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "core/game.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// 观测平面（位压缩与张量两种布局共用前四个通道的顺序）
+typedef enum {
+  OBS_PLANE_BODY, // 蛇身（含蛇头）
+  OBS_PLANE_HEAD, // 蛇头
+  OBS_PLANE_FOOD, // 食物
+  OBS_PLANE_WALL, // 墙：与棋盘边界相邻的最外一圈格子
+  OBS_PLANE_COUNT
+} ObservationPlane;
+
+// 张量通道：在四个0/1平面之后追加蛇身年龄通道
+typedef enum {
+  OBS_CHANNEL_AGE = OBS_PLANE_COUNT, // 蛇头为255，向蛇尾线性递减，空格为0
+  OBS_CHANNEL_COUNT
+} ObservationChannel;
+
+/**
+ * @brief 每个位压缩平面占用的64位字数（按行优先、低位在前存放）
+ * @param config 游戏配置
+ * @return 字数
+ */
+size_t observation_plane_words(const GameConfig *config);
+
+/**
+ * @brief 单个游戏的uint8张量字节数（OBS_CHANNEL_COUNT × 高 × 宽）
+ * @param config 游戏配置
+ * @return 字节数
+ */
+size_t observation_tensor_size(const GameConfig *config);
+
+/**
+ * @brief 把游戏编码为位压缩占用平面，不分配内存
+ * @param game 游戏指针
+ * @param planes 输出缓冲，至少OBS_PLANE_COUNT × observation_plane_words个字
+ */
+void encode_observation_planes(const Game *game, uint64_t *planes);
+
+/**
+ * @brief 把游戏编码为uint8张量（通道 × 高 × 宽），不分配内存
+ * @param game 游戏指针
+ * @param tensor 输出缓冲，至少observation_tensor_size字节
+ */
+void encode_observation_tensor(const Game *game, uint8_t *tensor);
+
+/**
+ * @brief 把多个游戏编码到连续的位压缩缓冲中（所有游戏的网格尺寸必须相同）
+ * @param games 游戏指针数组
+ * @param count 游戏数量
+ * @param planes 输出缓冲，每个游戏占OBS_PLANE_COUNT × observation_plane_words个字
+ */
+void encode_observation_planes_batch(const Game *const *games, int count,
+                                     uint64_t *planes);
+
+/**
+ * @brief 把多个游戏编码到连续的N × 通道 × 高 × 宽张量中（所有游戏的网格尺寸必须相同）
+ * @param games 游戏指针数组
+ * @param count 游戏数量
+ * @param tensor 输出缓冲，每个游戏占observation_tensor_size字节
+ */
+void encode_observation_tensor_batch(const Game *const *games, int count,
+                                     uint8_t *tensor);
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "core/food.h"
+#include "core/grid_layout.h"
+#include "core/snake.h"
+#include "core/state.h"
+#include <stdint.h>
+
+/**
+ * @brief 寻路器：所有缓冲在初始化时按棋盘大小分配，之后的搜索不分配也不清空内存
+ *
+ * 内部使用四周各加一圈墙的网格，邻居下标由step_grid_cell直接求得，无需边界判断。
+ * 各数组按所选的排列存放；大网格上Z序或分块排列让上下相邻的格子也大多落在
+ * 同一缓存行附近，泛洪式的搜索缺失更少。
+ * 每次搜索递增generation，各标记数组中等于当前generation的项才有效。
+ * 蛇身第i节（蛇头为0）在蛇移动length - i步后才离开，之前不可通行。
+ */
+typedef struct {
+  int gridWidth;           // 网格宽度
+  int gridHeight;          // 网格高度
+  GridLayout layout;       // 带墙网格的排列
+  int cellCount;           // 带墙网格的格子数
+  uint32_t generation;     // 当前搜索的代数
+  uint8_t *walls;          // 墙（棋盘外的一圈）
+  uint32_t *visitMarks;    // 已到达标记
+  uint32_t *occupiedMarks; // 蛇身占用标记
+  uint32_t *foodMarks;     // 食物标记
+  int *freeAt;             // 蛇身格子可通行的最早步数
+  int *distance;           // 从蛇头出发的步数
+  int *parent;             // 前驱格子
+  uint64_t *open;          // BFS队列或A*的二叉堆
+  int start;               // 最近一次搜索的起点
+  int target;              // 最近一次搜索的终点，无路径时为-1
+} PathFinder;
+
+/**
+ * @brief 初始化寻路器
+ * @param finder 寻路器指针
+ * @param gridWidth 网格宽度
+ * @param gridHeight 网格高度
+ * @param layout 缓冲的排列方式，小网格上行优先即可
+ */
+void init_path_finder(PathFinder *finder, int gridWidth, int gridHeight,
+                      GridLayoutKind layout);
+
+/**
+ * @brief 释放寻路器的缓冲
+ * @param finder 寻路器指针
+ */
+void cleanup_path_finder(PathFinder *finder);
+
+/**
+ * @brief 广度优先搜索从蛇头到最近食物的最短路径
+ * @param finder 寻路器指针
+ * @param snake 蛇指针
+ * @param foodManager 食物管理器指针
+ * @return 路径步数，没有可达的食物时返回-1
+ */
+int find_nearest_food_path(PathFinder *finder, const Snake *snake,
+                           const FoodManager *foodManager);
+
+/**
+ * @brief A*搜索从蛇头到指定格子的最短路径（曼哈顿距离启发）
+ * @param finder 寻路器指针
+ * @param snake 蛇指针
+ * @param targetX 目标X坐标
+ * @param targetY 目标Y坐标
+ * @return 路径步数，不可达时返回-1
+ */
+int find_path_to(PathFinder *finder, const Snake *snake, int targetX,
+                 int targetY);
+
+/**
+ * @brief 取出最近一次搜索得到的路径
+ * @param finder 寻路器指针
+ * @param moves 输出的移动方向（从蛇头开始）
+ * @param capacity moves的容量，路径更长时只写入前capacity步
+ * @return 路径步数，没有路径时返回-1
+ */
+int get_path_moves(const PathFinder *finder, Direction *moves, int capacity);
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * 策略网络的矩阵乘内核：对count个输入向量各做一次矩阵向量乘，
+ * y[b * ldy + r] = w[r] · x[b]，第b个输入向量从x + b * stride开始。
+ *
+ * w按行存放，行数为4的倍数，行宽stride为POLICY_ROW_ALIGN的倍数（补齐的部分
+ * 为0）。内核每次取4行权重，与两个输入向量同时求点积，权重从内存中读出一次
+ * 即可用于一批向量。int8内核的结果是精确的整数和，以float形式写出，各变体
+ * 结果相同；fp32内核的累加顺序不同，结果只在舍入上有差别。
+ *
+ * 每个指令集的实现在单独的编译单元中，编译时不支持该指令集则导出NULL，
+ * 由policy_net.c通过select_cpu_kernels选择。
+ */
+
+// 行宽对齐到的元素数，AVX-512内核一次处理32个int8
+#define POLICY_ROW_ALIGN 32
+
+// 内核内部的点积函数必须内联，向量数才会成为常量，累加器才能留在寄存器中
+#define POLICY_KERNEL_INLINE static inline __attribute__((always_inline))
+
+// 一个指令集的内核
+typedef struct {
+  void (*matmul_f32)(const float *w, int stride, int rows, const float *x,
+                     int count, float *y, int ldy);
+  void (*matmul_i8)(const int8_t *w, int stride, int rows, const int8_t *x,
+                    int count, float *y, int ldy);
+} PolicyKernels;
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+
+// SSE2的fp32内核，SSE4.2变体没有更快的写法，直接沿用
+void policy_matmul_f32_sse2(const float *w, int stride, int rows,
+                            const float *x, int count, float *y, int ldy);
+
+// 把4个累加器各自的4个分量求和，得到[sum(a), sum(b), sum(c), sum(d)]。
+// 各变体都用解包后交错相加来归约，不用依次相连的hadd
+static inline __m128 policy_reduce4_ps(__m128 a, __m128 b, __m128 c, __m128 d) {
+  __m128 ab = _mm_add_ps(_mm_unpacklo_ps(a, b), _mm_unpackhi_ps(a, b));
+  __m128 cd = _mm_add_ps(_mm_unpacklo_ps(c, d), _mm_unpackhi_ps(c, d));
+  return _mm_add_ps(_mm_movelh_ps(ab, cd), _mm_movehl_ps(cd, ab));
+}
+
+static inline __m128i policy_reduce4_epi32(__m128i a, __m128i b, __m128i c,
+                                           __m128i d) {
+  __m128i ab =
+      _mm_add_epi32(_mm_unpacklo_epi32(a, b), _mm_unpackhi_epi32(a, b));
+  __m128i cd =
+      _mm_add_epi32(_mm_unpacklo_epi32(c, d), _mm_unpackhi_epi32(c, d));
+  return _mm_add_epi32(_mm_unpacklo_epi64(ab, cd), _mm_unpackhi_epi64(ab, cd));
+}
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+
+// 256位的版本：在256位内同样交错相加，最后只跨一次128位
+static inline __m128 policy_reduce4_ps_avx2(__m256 a, __m256 b, __m256 c,
+                                            __m256 d) {
+  __m256 ab = _mm256_add_ps(_mm256_unpacklo_ps(a, b), _mm256_unpackhi_ps(a, b));
+  __m256 cd = _mm256_add_ps(_mm256_unpacklo_ps(c, d), _mm256_unpackhi_ps(c, d));
+  __m256 abcd = _mm256_add_ps(_mm256_shuffle_ps(ab, cd, 0x44),
+                              _mm256_shuffle_ps(ab, cd, 0xEE));
+  return _mm_add_ps(_mm256_castps256_ps128(abcd),
+                    _mm256_extractf128_ps(abcd, 1));
+}
+
+static inline __m128i policy_reduce4_epi32_avx2(__m256i a, __m256i b,
+                                                __m256i c, __m256i d) {
+  __m256i ab = _mm256_add_epi32(_mm256_unpacklo_epi32(a, b),
+                                _mm256_unpackhi_epi32(a, b));
+  __m256i cd = _mm256_add_epi32(_mm256_unpacklo_epi32(c, d),
+                                _mm256_unpackhi_epi32(c, d));
+  __m256i abcd = _mm256_add_epi32(_mm256_unpacklo_epi64(ab, cd),
+                                  _mm256_unpackhi_epi64(ab, cd));
+  return _mm_add_epi32(_mm256_castsi256_si128(abcd),
+                       _mm256_extracti128_si256(abcd, 1));
+}
+#endif
+
+extern const PolicyKernels *const policyKernelsScalar; // 总是可用
+extern const PolicyKernels *const policyKernelsSse2;   // CPU_FEATURE_SSE2
+extern const PolicyKernels *const policyKernelsSse42;  // CPU_FEATURE_SSE42
+extern const PolicyKernels *const policyKernelsAvx2;   // CPU_FEATURE_AVX2
+extern const PolicyKernels *const policyKernelsAvx512; // CPU_FEATURE_AVX512
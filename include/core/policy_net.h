@@ -0,0 +1,127 @@
+#pragma once
+
+#include "core/game.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * 内置神经网络机器人的推理引擎：若干全连接层，权重为fp32或int8（按输出行缩放），
+ * 输入为从游戏中提取的特征向量，输出为四个方向的分数。
+ *
+ * 权重文件格式（小端）：
+ *   文件头  uint32 magic, version, layerCount
+ *   每层    uint32 inputs, outputs, type, activation
+ *           fp32层：float weights[outputs][inputs], float bias[outputs]
+ *           int8层：float scales[outputs], int8 weights[outputs][inputs],
+ *                   float bias[outputs]
+ * int8层把输入按向量的最大绝对值动态量化为int8，用整数点积后再乘回两个缩放。
+ * 第一层的输入数必须为POLICY_FEATURE_COUNT，最后一层的输出数必须为4。
+ */
+
+#define POLICY_NET_MAGIC 0x4E504E53u // "SNPN"
+#define POLICY_NET_VERSION 1u
+// 批量推理时一次送入内核的游戏数，每层权重对这一批游戏只读取一次
+#define POLICY_BATCH_SIZE 16
+
+// 特征向量（extract_policy_features的输出顺序）
+typedef enum {
+  // 当前方向，独热编码，按Direction顺序共4个
+  POLICY_FEATURE_DIRECTION,
+  // 沿各方向移动是否立即死亡
+  POLICY_FEATURE_DANGER = POLICY_FEATURE_DIRECTION + 4,
+  // 最近的食物是否在各方向一侧
+  POLICY_FEATURE_FOOD = POLICY_FEATURE_DANGER + 4,
+  // 最近食物的相对X（除以宽度）
+  POLICY_FEATURE_FOOD_DX = POLICY_FEATURE_FOOD + 4,
+  POLICY_FEATURE_FOOD_DY, // 最近食物的相对Y（除以高度）
+  POLICY_FEATURE_HEAD_X,  // 蛇头X（除以宽度）
+  POLICY_FEATURE_HEAD_Y,  // 蛇头Y（除以高度）
+  POLICY_FEATURE_LENGTH,  // 蛇长度（除以格子数）
+  POLICY_FEATURE_COUNT
+} PolicyFeature;
+
+// 层的权重类型
+typedef enum {
+  POLICY_LAYER_FP32 = 0,
+  POLICY_LAYER_INT8 = 1,
+} PolicyLayerType;
+
+// 激活函数
+typedef enum {
+  POLICY_ACTIVATION_NONE = 0,
+  POLICY_ACTIVATION_RELU = 1,
+} PolicyActivation;
+
+// 全连接层。权重按行存放，每行补零到stride个元素，内核无需处理尾部
+typedef struct {
+  int inputs;                  // 输入数
+  int outputs;                 // 输出数
+  int stride;                  // 每行元素数（输入数向上取整到32的倍数）
+  PolicyLayerType type;        // 权重类型
+  PolicyActivation activation; // 激活函数
+  float *weights;              // fp32权重（outputs × stride）
+  int8_t *quantized;           // int8权重（outputs × stride）
+  float *scales;               // int8权重每行的缩放
+  float *bias;                 // 偏置
+} PolicyLayer;
+
+// 策略网络。推理使用网络内的缓冲，同一网络不能在多个线程中同时推理
+typedef struct {
+  int layerCount;         // 层数
+  PolicyLayer *layers;    // 各层
+  int maxStride;          // 单个向量的激活长度（各层宽度对齐后的最大值）
+  float *activations[2];  // 相邻两层交替使用的激活缓冲，每批游戏各一个向量
+  int8_t *quantizedInput; // int8层量化后的输入，每批游戏各一个向量
+  float inputScales[POLICY_BATCH_SIZE]; // int8层各输入向量的量化缩放
+} PolicyNet;
+
+/**
+ * @brief 从文件加载网络
+ * @param net 网络指针
+ * @param path 权重文件路径
+ * @return 成功返回true；文件不存在或格式不符时记录错误并返回false
+ */
+bool load_policy_net(PolicyNet *net, const char *path);
+
+/**
+ * @brief 释放网络
+ * @param net 网络指针
+ */
+void cleanup_policy_net(PolicyNet *net);
+
+/**
+ * @brief 提取特征向量
+ * @param snake 贪吃蛇指针
+ * @param foodManager 食物管理器指针
+ * @param state 游戏状态指针
+ * @param features 输出，POLICY_FEATURE_COUNT个元素
+ */
+void extract_policy_features(const Snake *snake,
+                             const FoodManager *foodManager,
+                             const GameStateData *state, float *features);
+
+/**
+ * @brief 对一个特征向量推理
+ * @param net 网络指针
+ * @param features 输入特征，POLICY_FEATURE_COUNT个元素
+ * @param scores 输出的四个方向的分数（按Direction顺序）
+ */
+void policy_net_forward(PolicyNet *net, const float *features, float *scores);
+
+/**
+ * @brief 对多个游戏批量推理，每POLICY_BATCH_SIZE个游戏调用一次矩阵乘内核
+ * @param net 网络指针
+ * @param games 游戏指针数组
+ * @param count 游戏数量
+ * @param scores 输出，每个游戏4个分数
+ */
+void policy_net_forward_batch(PolicyNet *net, const Game *const *games,
+                              int count, float *scores);
+
+/**
+ * @brief 为游戏选择方向：分数最高的非反向方向
+ * @param net 网络指针
+ * @param game 游戏指针
+ * @return 方向
+ */
+Direction policy_net_choose(PolicyNet *net, const Game *game);
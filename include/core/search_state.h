@@ -0,0 +1,81 @@
+#pragma once
+
+#include "core/game.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// 搜索局面支持的最大格子数（64 × 64，必须是2的幂）和最大食物数量
+#define SEARCH_MAX_CELLS 4096
+#define SEARCH_MAX_FOOD 32
+
+/**
+ * @brief 供搜索使用的紧凑局面：全部数据在结构体内，复制一份即可分叉，不分配内存
+ *
+ * 与step_game使用同一份规则（step_rules.h），食物生成使用同一随机数序列，
+ * 从游戏载入后用相同的方向序列步进，结果与游戏完全相同。
+ */
+typedef struct {
+  int gridWidth;                           // 网格宽度
+  int gridHeight;                          // 网格高度
+  int words;                               // 每张位图使用的64位字数
+  int length;                              // 蛇长度
+  int head;                                // 蛇头在body中的位置
+  int score;                               // 得分
+  Direction direction;                     // 当前移动方向
+  bool alive;                              // 蛇是否存活
+  int foodCount;                           // 食物数量
+  int maxFoodCount;                        // 最大食物数量
+  uint64_t rngState;                       // 食物随机数状态
+  uint64_t hash;                           // 蛇和食物的Zobrist哈希（增量维护）
+  uint16_t foods[SEARCH_MAX_FOOD];         // 食物格子
+  uint64_t occupied[SEARCH_MAX_CELLS / 64]; // 蛇身位图
+  uint64_t foodBits[SEARCH_MAX_CELLS / 64]; // 食物位图
+  uint16_t body[SEARCH_MAX_CELLS]; // 环形缓冲，从body[head]起依次为蛇头到蛇尾
+} SearchState;
+
+/**
+ * @brief 从游戏载入局面
+ * @param state 搜索局面指针
+ * @param game 游戏指针
+ * @return 成功返回true，网格或食物数量超出上限时返回false
+ */
+bool load_search_state(SearchState *state, const Game *game);
+
+/**
+ * @brief 复制局面，只复制实际使用的部分
+ * @param dst 目标局面
+ * @param src 源局面
+ */
+void copy_search_state(SearchState *dst, const SearchState *src);
+
+/**
+ * @brief 沿指定方向执行一次逻辑步进（与change_direction一样忽略反向）
+ * @param state 搜索局面指针
+ * @param direction 移动方向
+ * @return 蛇是否仍然存活
+ */
+bool step_search_state(SearchState *state, Direction direction);
+
+/**
+ * @brief 沿指定方向移动是否会立即死亡
+ * @param state 搜索局面指针
+ * @param direction 移动方向
+ * @return 会死亡返回true
+ */
+bool is_search_move_fatal(const SearchState *state, Direction direction);
+
+/**
+ * @brief 获取蛇头坐标
+ * @param state 搜索局面指针
+ * @param x 输出的X坐标
+ * @param y 输出的Y坐标
+ */
+void get_search_head(const SearchState *state, int *x, int *y);
+
+/**
+ * @brief 局面的Zobrist哈希（蛇头、蛇身各节的连接、食物、当前方向和得分），
+ *        与game_hash一致
+ * @param state 搜索局面指针
+ * @return 64位哈希
+ */
+uint64_t search_state_hash(const SearchState *state);
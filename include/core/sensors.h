@@ -0,0 +1,57 @@
+#pragma once
+
+#include "core/game.h"
+#include <stdbool.h>
+
+/**
+ * 射线传感器：从蛇头沿8个方向看出去，分别测量到墙、蛇身和食物的距离。
+ *
+ * 过蛇头的行、列和两条对角线各压缩为一个64位字（蛇身和食物各一组），
+ * 每条射线的最近目标用一次前导零或尾随零计数得到，不逐格检查碰撞。
+ * 网格宽高不能超过64（与位棋盘相同）。
+ */
+
+// 射线方向：前四个与Direction的顺序相同
+typedef enum {
+  SENSOR_RAY_UP,
+  SENSOR_RAY_DOWN,
+  SENSOR_RAY_LEFT,
+  SENSOR_RAY_RIGHT,
+  SENSOR_RAY_UP_LEFT,
+  SENSOR_RAY_UP_RIGHT,
+  SENSOR_RAY_DOWN_LEFT,
+  SENSOR_RAY_DOWN_RIGHT,
+  SENSOR_RAY_COUNT
+} SensorRay;
+
+// 每条射线测量的目标
+typedef enum {
+  SENSOR_TARGET_WALL, // 走出棋盘的步数
+  SENSOR_TARGET_BODY, // 最近的蛇身格子（含蛇尾）
+  SENSOR_TARGET_FOOD, // 最近的食物
+  SENSOR_TARGET_COUNT
+} SensorTarget;
+
+// 传感器值的个数，下标为 射线 × SENSOR_TARGET_COUNT + 目标
+#define SENSOR_COUNT (SENSOR_RAY_COUNT * SENSOR_TARGET_COUNT)
+
+/**
+ * @brief 计算一个游戏的射线传感器
+ *
+ * 每个值为距离（步数）的倒数，相邻格子为1，射线上没有该目标时为0。
+ *
+ * @param game 游戏指针
+ * @param sensors 输出，SENSOR_COUNT个元素
+ * @return 成功返回true；蛇为空或网格过大时输出全0并返回false
+ */
+bool extract_ray_sensors(const Game *game, float *sensors);
+
+/**
+ * @brief 批量计算多个游戏的射线传感器，各游戏的网格尺寸可以不同
+ * @param games 游戏指针数组
+ * @param count 游戏数量
+ * @param sensors 输出，每个游戏占SENSOR_COUNT个元素；失败的游戏输出全0
+ * @return 成功的游戏数
+ */
+int extract_ray_sensors_batch(const Game *const *games, int count,
+                              float *sensors);
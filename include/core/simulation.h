@@ -0,0 +1,128 @@
+#pragma once
+
+#include "core/game.h"
+#include <SDL3/SDL.h>
+
+// 模拟线程步长（纳秒），逻辑步进仍由moveInterval决定
+#define SIM_STEP_NS 1000000ULL
+// 输入队列容量（必须是2的幂）
+#define SIM_INPUT_QUEUE_SIZE 64
+
+// 网格坐标
+typedef struct {
+  int x; // 网格X坐标
+  int y; // 网格Y坐标
+} GridCell;
+
+// 渲染快照，发布后只读
+typedef struct {
+  GridCell *snakeCells;    // 蛇身格子（蛇头在前）
+  int snakeLength;         // 蛇身格子数量
+  GridCell *previousCells; // 上一次逻辑步进时的蛇身格子，用于插值
+  int previousLength;      // 上一次逻辑步进时的蛇身格子数量
+  GridCell *foodCells;     // 食物格子
+  int foodCount;           // 食物数量
+  int score;               // 当前得分
+  GameState state;         // 当前游戏状态
+  unsigned int tickCount;  // 已执行的逻辑步数
+  Uint64 tickTimeNS;       // 最近一次逻辑步进的时间（SDL_GetTicksNS）
+  float moveInterval;      // 当前移动间隔（秒）
+} GameSnapshot;
+
+// 模拟线程输入类型
+typedef enum {
+  SIM_INPUT_DIRECTION,     // 改变方向
+  SIM_INPUT_COMMAND,       // 游戏命令
+  SIM_INPUT_MOVE_INTERVAL, // 修改移动间隔（配置热重载）
+} SimInputType;
+
+// 模拟线程输入
+typedef struct {
+  SimInputType type;
+  union {
+    Direction direction;
+    GameCommand command;
+    float moveInterval;
+  };
+} SimInput;
+
+// 单生产者单消费者输入队列（渲染线程写入，模拟线程读取）
+typedef struct {
+  SimInput items[SIM_INPUT_QUEUE_SIZE];
+  SDL_AtomicInt head; // 下一个写入位置，只由生产者修改
+  SDL_AtomicInt tail; // 下一个读取位置，只由消费者修改
+} SimInputQueue;
+
+// 独立线程上的游戏模拟
+typedef struct {
+  Game game;                 // 游戏，只由模拟线程访问
+  GameSnapshot snapshots[3]; // 三缓冲快照
+  GridCell *tickCells[2];    // 最近两次逻辑步进的蛇身（[0]较早，[1]最新）
+  int tickLength[2];         // 对应的蛇身格子数量
+  int writeIndex;            // 模拟线程正在写入的缓冲
+  int readIndex;             // 渲染线程正在读取的缓冲
+  SDL_AtomicInt middle;      // 交换用缓冲下标，附带新数据标志
+  SimInputQueue input;       // 输入队列
+  SDL_Thread *thread;        // 模拟线程
+  SDL_AtomicInt running;     // 运行标志
+} Simulation;
+
+/**
+ * @brief 初始化游戏并启动模拟线程
+ * @param sim 模拟指针
+ * @param config 游戏配置
+ * @return 成功返回true，失败返回false
+ */
+bool start_simulation(Simulation *sim, const GameConfig *config);
+
+/**
+ * @brief 停止模拟线程并释放资源
+ * @param sim 模拟指针
+ */
+void stop_simulation(Simulation *sim);
+
+/**
+ * @brief 向模拟线程发送输入（只能由单一线程调用）
+ * @param sim 模拟指针
+ * @param input 输入
+ * @return 队列已满时返回false
+ */
+bool push_sim_input(Simulation *sim, SimInput input);
+
+/**
+ * @brief 获取最新发布的快照（只能由单一线程调用，无锁且不阻塞）
+ * @param sim 模拟指针
+ * @return 最新快照，在下一次调用前保持有效
+ */
+const GameSnapshot *acquire_snapshot(Simulation *sim);
+
+/**
+ * @brief 按配置分配快照的缓冲
+ * @param snapshot 快照指针
+ * @param config 游戏配置（决定蛇身和食物的容量）
+ */
+void init_game_snapshot(GameSnapshot *snapshot, const GameConfig *config);
+
+/**
+ * @brief 释放快照的缓冲
+ * @param snapshot 快照指针
+ */
+void cleanup_game_snapshot(GameSnapshot *snapshot);
+
+/**
+ * @brief 直接由游戏填写快照（不经过模拟线程），不记录上一步的位置
+ * @param snapshot 由init_game_snapshot分配的快照
+ * @param game 游戏指针
+ */
+void fill_game_snapshot(GameSnapshot *snapshot, const Game *game);
+
+/**
+ * @brief 计算快照中第index节蛇身在两次逻辑步进之间的插值位置
+ * @param snapshot 快照
+ * @param index 蛇身下标（0为蛇头）
+ * @param alpha 插值因子（0为上一步位置，1为当前位置）
+ * @param x 返回的X坐标（网格单位）
+ * @param y 返回的Y坐标（网格单位）
+ */
+void interpolate_snake_cell(const GameSnapshot *snapshot, int index,
+                            float alpha, float *x, float *y);
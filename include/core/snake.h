@@ -2,6 +2,7 @@
 
 #include "utils/knode.h"
 #include <stdbool.h>
+#include <stdint.h>
 
 // 蛇身体节点结构体
 typedef struct {
@@ -12,9 +13,10 @@ typedef struct {
 
 // 蛇结构体
 typedef struct {
-  KNode head;   // 链表头节点
-  int length;   // 蛇的长度
-  bool isAlive; // 蛇是否存活
+  KNode head;    // 链表头节点
+  int length;    // 蛇的长度
+  bool isAlive;  // 蛇是否存活
+  uint64_t hash; // 蛇头和蛇身各节的Zobrist哈希（增量维护）
 } Snake;
 
 /**
@@ -44,6 +46,15 @@ void cleanup_snake(Snake *snake);
 bool move_snake(Snake *snake, int direction, int gridWidth, int gridHeight,
                 bool shouldGrow);
 
+/**
+ * @brief 把蛇头移到相邻的格子，不做边界和碰撞检查（调用方已确认可以进入）
+ * @param snake 蛇指针（至少一节）
+ * @param newHeadX 新蛇头的X坐标
+ * @param newHeadY 新蛇头的Y坐标
+ * @param shouldGrow 是否增长蛇（为false时去掉蛇尾）
+ */
+void advance_snake(Snake *snake, int newHeadX, int newHeadY, bool shouldGrow);
+
 /**
  * @brief 检查蛇是否与位置碰撞
  * @param snake 蛇指针
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "core/grid_layout.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * 稀疏分块网格：每格一个uint32值，0表示空。
+ *
+ * 网格划分为SPARSE_CHUNK_SIZE × SPARSE_CHUNK_SIZE的分块，分块在第一次写入
+ * 非零值时才分配，由分块坐标到分块的散列表（开放寻址）索引。内存与有内容的
+ * 区域成正比，而不是与网格尺寸成正比；读写一格是一次散列查找，O(1)。
+ *
+ * 块内格子按初始化时选择的排列存放（grid_layout.h）。按邻域扫描分块时，
+ * Z序或分块排列让上下相邻的格子也落在同一缓存行附近。
+ *
+ * 每个分块记录非零格子数。变为空的分块不会立即释放，由compact_sparse_grid
+ * 在单线程中统一回收，空分块占已分配分块的1/8以上时才回收。
+ *
+ * 多线程：set_sparse_cell可在多个线程中同时调用，前提是各线程写入不同的格子、
+ * 期间没有线程读取这些格子，且事先用reserve_sparse_chunks预留了足够的容量
+ * （散列表在写入时不会扩容）。其他函数只能在单个线程中调用。
+ */
+
+// 分块边长的以2为底的对数
+#define SPARSE_CHUNK_SHIFT 6
+// 分块边长（格子数）
+#define SPARSE_CHUNK_SIZE (1 << SPARSE_CHUNK_SHIFT)
+
+// 分块
+typedef struct {
+  uint32_t cells[SPARSE_CHUNK_SIZE * SPARSE_CHUNK_SIZE]; // 按chunkLayout存放
+  int occupied; // 非零格子数（原子读写）
+} SparseChunk;
+
+// 散列表条目
+typedef struct {
+  uint64_t key;       // 分块坐标的编码 + 1，0表示空条目
+  SparseChunk *chunk; // 分块，创建期间或释放后为NULL
+} SparseSlot;
+
+// 稀疏分块网格
+typedef struct {
+  int width;              // 网格宽度
+  int height;             // 网格高度
+  GridLayout chunkLayout; // 块内格子的排列
+  SparseSlot *slots;      // 散列表
+  int slotCapacity;       // 散列表容量（2的幂）
+  int keyCount;           // 有键的条目数，含分块已释放的（原子读写）
+  int chunkCount;         // 已分配的分块数（原子读写）
+  int emptyChunks;        // 已分配但为空的分块数（原子读写）
+} SparseGrid;
+
+static inline uint64_t sparse_chunk_key(int x, int y) {
+  return (((uint64_t)(uint32_t)(y >> SPARSE_CHUNK_SHIFT) << 32) |
+          (uint32_t)(x >> SPARSE_CHUNK_SHIFT)) +
+         1;
+}
+
+static inline uint32_t sparse_slot_of(const SparseGrid *grid, uint64_t key) {
+  return (uint32_t)((key * 0x9E3779B97F4A7C15ULL) >> 32) &
+         (uint32_t)(grid->slotCapacity - 1);
+}
+
+static inline uint32_t sparse_cell_offset(const SparseGrid *grid, int x,
+                                          int y) {
+  return get_grid_cell_index(&grid->chunkLayout, x & (SPARSE_CHUNK_SIZE - 1),
+                             y & (SPARSE_CHUNK_SIZE - 1));
+}
+
+/**
+ * @brief 查找(x, y)所在的分块
+ * @param grid 网格指针
+ * @param x X坐标（必须在网格内）
+ * @param y Y坐标（必须在网格内）
+ * @return 分块，未分配时返回NULL
+ */
+static inline SparseChunk *find_sparse_chunk(const SparseGrid *grid, int x,
+                                             int y) {
+  const uint64_t key = sparse_chunk_key(x, y);
+  const uint32_t mask = (uint32_t)(grid->slotCapacity - 1);
+  for (uint32_t slot = sparse_slot_of(grid, key);;
+       slot = (slot + 1) & mask) {
+    const uint64_t found =
+        __atomic_load_n(&grid->slots[slot].key, __ATOMIC_ACQUIRE);
+    if (found == key) {
+      return __atomic_load_n(&grid->slots[slot].chunk, __ATOMIC_ACQUIRE);
+    }
+    if (found == 0) {
+      return NULL;
+    }
+  }
+}
+
+/**
+ * @brief 读取一格
+ * @param grid 网格指针
+ * @param x X坐标（必须在网格内）
+ * @param y Y坐标（必须在网格内）
+ * @return 格子的值，分块未分配时为0
+ */
+static inline uint32_t get_sparse_cell(const SparseGrid *grid, int x, int y) {
+  const SparseChunk *chunk = find_sparse_chunk(grid, x, y);
+  return chunk != NULL ? chunk->cells[sparse_cell_offset(grid, x, y)] : 0;
+}
+
+/**
+ * @brief 初始化空网格，不分配任何分块
+ * @param grid 网格指针
+ * @param width 网格宽度
+ * @param height 网格高度
+ * @param layout 块内格子的排列方式
+ */
+void init_sparse_grid(SparseGrid *grid, int width, int height,
+                      GridLayoutKind layout);
+
+/**
+ * @brief 释放全部分块和散列表
+ * @param grid 网格指针
+ */
+void cleanup_sparse_grid(SparseGrid *grid);
+
+/**
+ * @brief 预留容量，保证之后再分配count个分块时散列表无需扩容
+ * @param grid 网格指针
+ * @param count 最多新增的分块数
+ */
+void reserve_sparse_chunks(SparseGrid *grid, int count);
+
+/**
+ * @brief 写入一格，需要时分配分块并更新分块的非零格子数
+ * @param grid 网格指针
+ * @param x X坐标（必须在网格内）
+ * @param y Y坐标（必须在网格内）
+ * @param value 新值，0表示清空
+ */
+void set_sparse_cell(SparseGrid *grid, int x, int y, uint32_t value);
+
+/**
+ * @brief 空分块较多时释放它们，否则直接返回
+ * @param grid 网格指针
+ * @return 释放的分块数
+ */
+int compact_sparse_grid(SparseGrid *grid);
+
+/**
+ * @brief (x, y)所在分块的非零格子数，可用于跳过整块为空的区域
+ * @param grid 网格指针
+ * @param x X坐标（必须在网格内）
+ * @param y Y坐标（必须在网格内）
+ * @return 非零格子数，分块未分配时为0
+ */
+int get_sparse_chunk_occupancy(const SparseGrid *grid, int x, int y);
+
+/**
+ * @brief 网格占用的内存（分块和散列表）
+ * @param grid 网格指针
+ * @return 字节数
+ */
+size_t sparse_grid_bytes(const SparseGrid *grid);
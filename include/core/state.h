@@ -37,6 +37,7 @@ typedef struct {
   bool directionChanged;      // 方向是否已改变
   Direction currentDirection; // 当前移动方向
   Direction nextDirection;    // 下一个移动方向
+  unsigned int tickCount;     // 已执行的逻辑步数
 } GameStateData;
 
 /**
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "core/food.h"
+#include "core/state.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * 逻辑步进的规则，step_game和step_search_state共用，搜索因此与游戏逐步一致。
+ *
+ * 规则只通过回调表读写局面，自身不分配内存：游戏的回调操作链表（增长时
+ * 分配节点），搜索局面的回调操作位图和环形缓冲。回调表是常量，规则函数
+ * 内联进调用方后，编译器可以直接调用甚至内联各个回调。
+ *
+ * 一步的顺序：
+ *   1. 检查蛇头所在格子的食物，有食物则这一步增长（蛇尾不动）
+ *   2. 蛇头沿方向前进，出界或撞到蛇身即死亡；蛇尾在移动前仍算占用
+ *   3. 吃到的食物即使蛇在这一步死亡也会移除并得分，随后补充一个食物
+ *   4. 食物数量未满时再补充一个
+ *
+ * 食物的位置：先随机尝试FOOD_SPAWN_ATTEMPTS次（每次依次取x、y），全部落在
+ * 蛇身或食物上时，再取一个随机数在所有空格中均匀选一个。
+ */
+
+// 放置食物时随机尝试的次数
+#define FOOD_SPAWN_ATTEMPTS 100
+
+// 回调的上下文（游戏或搜索局面）
+typedef void *StepContext;
+
+// 一步中对局面的读写
+typedef struct {
+  // (x, y)是否有食物
+  bool (*has_food)(StepContext context, int x, int y);
+  // (x, y)是否被蛇身占用（含蛇尾）
+  bool (*is_occupied)(StepContext context, int x, int y);
+  // 蛇头移到(x, y)，grow为false时去掉蛇尾；(x, y)已确认可以进入
+  void (*advance)(StepContext context, int x, int y, bool grow);
+  // 移除(x, y)的食物，返回得分
+  int (*eat_food)(StepContext context, int x, int y);
+  // 食物数量未满时补充一个（通常调用place_food_by_rules）
+  void (*spawn_food)(StepContext context);
+} StepRules;
+
+// 放置食物时对局面的读写
+typedef struct {
+  // (x, y)既不是蛇身也不是食物
+  bool (*is_free)(StepContext context, int x, int y);
+  // 空格数量
+  int (*count_free)(StepContext context);
+  // 按从上到下、从左到右的顺序，第pick个（从0开始）空格
+  void (*find_free)(StepContext context, int pick, int *x, int *y);
+  // 在(x, y)放置一个食物
+  void (*add_food)(StepContext context, int x, int y);
+} FoodSpawnRules;
+
+/**
+ * @brief 按规则放置一个食物，调用方已确认食物数量未满
+ * @param rules 回调表
+ * @param context 回调的上下文
+ * @param gridWidth 网格宽度
+ * @param gridHeight 网格高度
+ * @param rngState 食物随机数状态（next_food_random）
+ * @return 放置成功返回true，没有空格时返回false
+ */
+static inline bool place_food_by_rules(const FoodSpawnRules *rules,
+                                       StepContext context, int gridWidth,
+                                       int gridHeight, uint64_t *rngState) {
+  for (int attempt = 0; attempt < FOOD_SPAWN_ATTEMPTS; attempt++) {
+    int x = (int)(next_food_random(rngState) % (uint32_t)gridWidth);
+    int y = (int)(next_food_random(rngState) % (uint32_t)gridHeight);
+    if (rules->is_free(context, x, y)) {
+      rules->add_food(context, x, y);
+      return true;
+    }
+  }
+
+  // 棋盘接近填满时随机尝试大多落空，在所有空格中均匀选一个兜底
+  int freeCells = rules->count_free(context);
+  if (freeCells <= 0) {
+    return false;
+  }
+  int pick = (int)(next_food_random(rngState) % (uint32_t)freeCells);
+  int x, y;
+  rules->find_free(context, pick, &x, &y);
+  rules->add_food(context, x, y);
+  return true;
+}
+
+/**
+ * @brief 按规则执行一次逻辑步进
+ * @param rules 回调表
+ * @param context 回调的上下文
+ * @param headX 移动前的蛇头X坐标
+ * @param headY 移动前的蛇头Y坐标
+ * @param direction 移动方向（调用方已排除反向）
+ * @param gridWidth 网格宽度
+ * @param gridHeight 网格高度
+ * @param score 得分，吃到食物时增加
+ * @return 蛇是否仍然存活
+ */
+static inline bool step_by_rules(const StepRules *rules, StepContext context,
+                                 int headX, int headY, Direction direction,
+                                 int gridWidth, int gridHeight, int *score) {
+  // 先检查是否吃到食物（在移动前检查当前位置）
+  const bool grow = rules->has_food(context, headX, headY);
+
+  int x = headX;
+  int y = headY;
+  switch (direction) {
+  case DIRECTION_UP:
+    y--;
+    break;
+  case DIRECTION_DOWN:
+    y++;
+    break;
+  case DIRECTION_LEFT:
+    x--;
+    break;
+  case DIRECTION_RIGHT:
+    x++;
+    break;
+  }
+  const bool alive = x >= 0 && x < gridWidth && y >= 0 && y < gridHeight &&
+                     !rules->is_occupied(context, x, y);
+  if (alive) {
+    rules->advance(context, x, y, grow);
+  }
+
+  if (grow) {
+    *score += rules->eat_food(context, headX, headY);
+    rules->spawn_food(context);
+  }
+  rules->spawn_food(context);
+  return alive;
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// 每个桶的条目数，一个桶正好占一条64字节的缓存行
+#define TRANSPOSITION_BUCKET_SIZE 4
+
+// 条目数据，打包在一个64位字中
+typedef struct {
+  int32_t value;      // 价值，含义由使用方决定
+  uint16_t depth;     // 可信度（搜索深度或样本数），替换时优先保留较大者
+  uint8_t move;       // 最佳方向
+  uint8_t generation; // 写入时的代数，由表填写
+} TranspositionData;
+
+/**
+ * @brief 条目：check为键与数据的异或
+ *
+ * 两个字分别原子地读写而不加锁，另一线程同时写入时可能读到新旧混合的两个字，
+ * 此时check ^ data与键不符，按未命中处理。
+ */
+typedef struct {
+  uint64_t check; // 键 ^ 数据
+  uint64_t data;  // 打包后的TranspositionData，0表示空条目
+} TranspositionSlot;
+
+// 命中率等统计，每个线程各自累计，避免共享计数器的缓存行争用
+typedef struct {
+  uint64_t probes;     // 查询次数
+  uint64_t hits;       // 命中次数
+  uint64_t collisions; // 未命中且桶中全是其他局面的次数
+  uint64_t stores;     // 写入次数
+  uint64_t overwrites; // 写入时替换掉其他局面的次数
+} TranspositionStats;
+
+// 多线程共享的置换表，条目数为2的幂
+typedef struct {
+  void *memory;             // 分配的内存（未对齐）
+  TranspositionSlot *slots; // 按缓存行对齐的条目
+  uint64_t bucketMask;      // 桶数 - 1
+  uint8_t generation;       // 当前代数，每次搜索开始时递增
+} TranspositionTable;
+
+/**
+ * @brief 初始化置换表，桶数取不超过给定内存的最大2的幂
+ * @param table 置换表指针
+ * @param megabytes 内存大小（MB），至少为一个桶
+ */
+void init_transposition_table(TranspositionTable *table, size_t megabytes);
+
+/**
+ * @brief 释放置换表
+ * @param table 置换表指针
+ */
+void cleanup_transposition_table(TranspositionTable *table);
+
+/**
+ * @brief 清空全部条目
+ * @param table 置换表指针
+ */
+void clear_transposition_table(TranspositionTable *table);
+
+/**
+ * @brief 进入新的一代：旧条目保留可查，但替换时优先被淘汰。只能在没有线程
+ *        访问置换表时调用。代数每254代回绕一次，回绕时遍历全表，
+ *        把所有旧条目标为旧代
+ * @param table 置换表指针
+ */
+void new_transposition_generation(TranspositionTable *table);
+
+/**
+ * @brief 预取键所在的桶，在知道键之后、查询之前尽早调用
+ * @param table 置换表指针
+ * @param key 局面哈希
+ */
+static inline void prefetch_transposition(const TranspositionTable *table,
+                                          uint64_t key) {
+  __builtin_prefetch(
+      &table->slots[(key & table->bucketMask) * TRANSPOSITION_BUCKET_SIZE]);
+}
+
+/**
+ * @brief 查询局面
+ * @param table 置换表指针
+ * @param key 局面哈希
+ * @param data 命中时输出的数据
+ * @param stats 统计，可为NULL
+ * @return 命中返回true
+ */
+bool probe_transposition(const TranspositionTable *table, uint64_t key,
+                         TranspositionData *data, TranspositionStats *stats);
+
+/**
+ * @brief 写入局面：同一局面直接覆盖，否则替换桶中旧代或可信度最低的条目
+ * @param table 置换表指针
+ * @param key 局面哈希
+ * @param data 数据（generation由表填写）
+ * @param stats 统计，可为NULL
+ */
+void store_transposition(TranspositionTable *table, uint64_t key,
+                         const TranspositionData *data,
+                         TranspositionStats *stats);
+
+/**
+ * @brief 把一个线程的统计累加到总计中
+ * @param total 总计
+ * @param stats 线程的统计
+ */
+void merge_transposition_stats(TranspositionStats *total,
+                               const TranspositionStats *stats);
+
+/**
+ * @brief 命中率
+ * @param stats 统计
+ * @return 命中次数 / 查询次数，没有查询时为0
+ */
+double transposition_hit_rate(const TranspositionStats *stats);
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "core/state.h"
+#include <stdint.h>
+
+// Zobrist哈希：局面哈希是所有(格子, 内容)键的异或，增删一个棋子只需异或一次。
+// 键由坐标经splitmix64混合得到，相当于一张无需初始化、不限棋盘大小的随机表。
+// 蛇头单独一个键，其余各节的键带上通向前一节（靠近蛇头）的方向，
+// 从蛇头沿这些方向可以还原整条蛇，格子相同而蛇头或顺序不同的蛇哈希不同
+
+// 格子内容
+typedef enum {
+  ZOBRIST_HEAD, // 蛇头
+  ZOBRIST_FOOD, // 食物
+  ZOBRIST_BODY, // 蛇身，加上通向前一节的方向（ZOBRIST_BODY + Direction）
+} ZobristPiece;
+
+// splitmix64的混合函数
+static inline uint64_t zobrist_mix(uint64_t z) {
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+// (格子, 内容)的键
+static inline uint64_t zobrist_cell_key(int x, int y, ZobristPiece piece) {
+  uint64_t cell = ((uint64_t)(uint32_t)x << 32) | (uint32_t)y;
+  return zobrist_mix(cell + (uint64_t)(piece + 1) * 0x9E3779B97F4A7C15ULL);
+}
+
+// 从(x, y)指向相邻格子(toX, toY)的方向
+static inline Direction zobrist_link(int x, int y, int toX, int toY) {
+  if (toY != y) {
+    return toY < y ? DIRECTION_UP : DIRECTION_DOWN;
+  }
+  return toX < x ? DIRECTION_LEFT : DIRECTION_RIGHT;
+}
+
+// 蛇身一节的键：所在格子和通向前一节(toX, toY)的方向
+static inline uint64_t zobrist_body_key(int x, int y, int toX, int toY) {
+  return zobrist_cell_key(
+      x, y, (ZobristPiece)(ZOBRIST_BODY + zobrist_link(x, y, toX, toY)));
+}
+
+// 方向的键
+static inline uint64_t zobrist_direction_key(Direction direction) {
+  return zobrist_mix(0xD1B54A32D192ED03ULL + (uint64_t)direction);
+}
+
+// 得分的键
+static inline uint64_t zobrist_score_key(int score) {
+  return zobrist_mix(0x8CB92BA72F3D8DD7ULL + (uint64_t)(uint32_t)score);
+}
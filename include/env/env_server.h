@@ -0,0 +1,117 @@
+#pragma once
+
+// 共享内存环境服务：服务进程托管N个环境，客户端进程通过POSIX共享内存
+// 写入动作、读取结果和观测。一次请求步进整批环境，只需一次唤醒。
+// 仅支持POSIX系统，同一时刻只允许一个客户端。
+//
+// 共享内存布局（各数组起始位置按64字节对齐，偏移量记录在头部）：
+//   EnvShmHeader
+//   int32_t       actions[envCount]
+//   SnakeEnvStep  results[envCount]
+//   uint8_t       observations[envCount][observationSize]
+
+#include "env/snake_env.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ENV_SHM_MAGIC 0x454B4E53u // "SNKE"
+#define ENV_SHM_VERSION 1
+
+// 请求命令
+typedef enum {
+  ENV_COMMAND_STEP = 1,     // 按actions步进所有环境
+  ENV_COMMAND_RESET = 2,    // 重置所有环境
+  ENV_COMMAND_SHUTDOWN = 3, // 停止服务
+} EnvCommand;
+
+// 共享内存头部（布局固定，其他语言的客户端可按此结构直接访问）
+typedef struct {
+  uint32_t magic;              // ENV_SHM_MAGIC，服务端初始化完成后最后写入
+  uint32_t version;            // ENV_SHM_VERSION
+  uint32_t envCount;           // 环境数量
+  uint32_t observationSize;    // 每个环境的观测字节数
+  uint64_t actionsOffset;      // 动作数组的字节偏移
+  uint64_t resultsOffset;      // 结果数组的字节偏移
+  uint64_t observationsOffset; // 观测数组的字节偏移
+  uint64_t totalSize;          // 共享内存总字节数
+  SnakeEnvConfig config;       // 环境配置
+  uint32_t command;            // 当前请求的命令（EnvCommand）
+  uint32_t reserved0[13];
+  // 门铃（只能用原子操作访问，各占一个缓存行）：客户端写好动作和命令后
+  // 递增requestSeq；服务端处理完后把responseSeq设为相同的值。两者都可作为futex等待
+  uint32_t requestSeq;
+  uint32_t reserved1[15];
+  uint32_t responseSeq;
+  uint32_t reserved2[15];
+} EnvShmHeader;
+
+// 客户端句柄（不透明）
+typedef struct EnvClient EnvClient;
+
+/**
+ * @brief 创建共享内存并运行环境服务，直到收到停止命令或stop被置位
+ * @param name 共享内存名称（以'/'开头）
+ * @param config 环境配置
+ * @param envCount 环境数量
+ * @param seed 随机数种子，第i个环境使用seed + i
+ * @param stop 外部停止标志，可为NULL
+ * @return 正常停止返回0，失败返回-1
+ */
+SNAKE_ENV_API int env_server_run(const char *name, const SnakeEnvConfig *config,
+                                 uint32_t envCount, uint64_t seed,
+                                 const volatile int *stop);
+
+/**
+ * @brief 连接到已运行的环境服务
+ * @param name 共享内存名称
+ * @return 客户端句柄，失败时返回NULL
+ */
+SNAKE_ENV_API EnvClient *env_client_open(const char *name);
+
+/**
+ * @brief 断开连接
+ * @param client 客户端句柄
+ */
+SNAKE_ENV_API void env_client_close(EnvClient *client);
+
+/**
+ * @brief 获取共享内存头部（环境数量、观测大小等）
+ * @param client 客户端句柄
+ * @return 头部指针
+ */
+SNAKE_ENV_API const EnvShmHeader *env_client_header(const EnvClient *client);
+
+/**
+ * @brief 动作数组（在env_client_request之前写入）
+ * @param client 客户端句柄
+ * @return 动作数组，长度为envCount
+ */
+SNAKE_ENV_API int32_t *env_client_actions(EnvClient *client);
+
+/**
+ * @brief 结果数组（env_client_request返回后有效）
+ * @param client 客户端句柄
+ * @return 结果数组，长度为envCount
+ */
+SNAKE_ENV_API const SnakeEnvStep *env_client_results(const EnvClient *client);
+
+/**
+ * @brief 观测数组（env_client_request返回后有效）
+ * @param client 客户端句柄
+ * @return 连续的envCount × observationSize字节
+ */
+SNAKE_ENV_API const uint8_t *env_client_observations(const EnvClient *client);
+
+/**
+ * @brief 发送一次请求并等待服务端处理完成
+ * @param client 客户端句柄
+ * @param command 命令
+ * @return 成功返回0，服务端停止时返回-1
+ */
+SNAKE_ENV_API int env_client_request(EnvClient *client, EnvCommand command);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,173 @@
+#pragma once
+
+// 训练环境C接口：作为共享库(snake-env)发布，供Python/C++通过FFI调用。
+// 只依赖标准头文件，结构体布局和函数签名在同一个主版本内保持不变。
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(_WIN32)
+#ifdef SNAKE_ENV_BUILD
+#define SNAKE_ENV_API __declspec(dllexport)
+#else
+#define SNAKE_ENV_API __declspec(dllimport)
+#endif
+#else
+#define SNAKE_ENV_API __attribute__((visibility("default")))
+#endif
+
+// 接口版本：主版本不兼容时递增，次版本只追加功能
+#define SNAKE_ENV_VERSION_MAJOR 1
+#define SNAKE_ENV_VERSION_MINOR 2
+#define SNAKE_ENV_VERSION                                                      \
+  ((SNAKE_ENV_VERSION_MAJOR << 16) | SNAKE_ENV_VERSION_MINOR)
+
+// 动作，与游戏内方向取值一致；其他取值表示保持当前方向
+typedef enum {
+  SNAKE_ENV_ACTION_UP = 0,
+  SNAKE_ENV_ACTION_DOWN = 1,
+  SNAKE_ENV_ACTION_LEFT = 2,
+  SNAKE_ENV_ACTION_RIGHT = 3,
+  SNAKE_ENV_ACTION_NONE = -1,
+} SnakeEnvAction;
+
+// 渲染的像素格式（1.2新增）
+typedef enum {
+  SNAKE_ENV_FORMAT_RGB = 0,  // 每像素3字节
+  SNAKE_ENV_FORMAT_GRAY = 1, // 每像素1字节（亮度）
+} SnakeEnvPixelFormat;
+
+// 环境句柄（不透明）
+typedef struct SnakeEnv SnakeEnv;
+
+// 环境配置
+typedef struct {
+  int32_t gridWidth;          // 网格宽度
+  int32_t gridHeight;         // 网格高度
+  int32_t initialSnakeLength; // 初始蛇长度
+  int32_t maxFoodCount;       // 最大食物数量
+  int32_t maxEpisodeSteps;    // 单局最大步数，0表示不限制
+  float deathReward;          // 死亡时的奖励（通常为负数）
+} SnakeEnvConfig;
+
+// 单步结果（由调用者分配）
+typedef struct {
+  float reward;          // 本步奖励：吃到食物得食物价值，死亡得deathReward
+  int32_t done;          // 本局是否结束（结束后环境已自动重置）
+  int32_t truncated;     // 是否因达到maxEpisodeSteps而结束
+  int32_t score;         // 本步结束时的得分（结束时为最终得分）
+  int32_t length;        // 本步结束时的蛇长度
+  uint32_t episodeSteps; // 本局已执行的步数
+  uint32_t episode;      // 本步所属的局数（从0开始）
+} SnakeEnvStep;
+
+/**
+ * @brief 获取共享库实现的接口版本，调用者应检查主版本是否一致
+ * @return SNAKE_ENV_VERSION
+ */
+SNAKE_ENV_API uint32_t snake_env_version(void);
+
+/**
+ * @brief 获取默认配置
+ * @param config 输出的配置
+ */
+SNAKE_ENV_API void snake_env_default_config(SnakeEnvConfig *config);
+
+/**
+ * @brief 创建环境并开始第一局
+ * @param config 环境配置
+ * @param seed 随机数种子（相同种子和动作序列得到相同的结果）
+ * @return 环境句柄，配置无效时返回NULL
+ */
+SNAKE_ENV_API SnakeEnv *snake_env_create(const SnakeEnvConfig *config,
+                                         uint64_t seed);
+
+/**
+ * @brief 销毁环境
+ * @param env 环境句柄
+ */
+SNAKE_ENV_API void snake_env_destroy(SnakeEnv *env);
+
+/**
+ * @brief 结束当前局并开始新的一局
+ * @param env 环境句柄
+ */
+SNAKE_ENV_API void snake_env_reset(SnakeEnv *env);
+
+/**
+ * @brief 执行一步（一次逻辑步进），本局结束时自动重置
+ * @param env 环境句柄
+ * @param action 动作（SnakeEnvAction）
+ * @param result 输出的单步结果
+ */
+SNAKE_ENV_API void snake_env_step(SnakeEnv *env, int32_t action,
+                                  SnakeEnvStep *result);
+
+/**
+ * @brief 批量执行一步
+ * @param envs 环境句柄数组
+ * @param count 环境数量
+ * @param actions 每个环境的动作
+ * @param results 每个环境的单步结果
+ */
+SNAKE_ENV_API void snake_env_step_many(SnakeEnv *const *envs, int32_t count,
+                                       const int32_t *actions,
+                                       SnakeEnvStep *results);
+
+/**
+ * @brief 观测张量的字节数（通道 × 高 × 宽，uint8）
+ * @param env 环境句柄
+ * @return 字节数
+ */
+SNAKE_ENV_API size_t snake_env_observation_size(const SnakeEnv *env);
+
+/**
+ * @brief 把当前局面编码为观测张量，写入调用者提供的缓冲
+ * @param env 环境句柄
+ * @param observation 输出缓冲，至少snake_env_observation_size字节
+ */
+SNAKE_ENV_API void snake_env_observe(const SnakeEnv *env,
+                                     uint8_t *observation);
+
+/**
+ * @brief 当前局面的64位Zobrist哈希，可用于确定性校验和回放验证（1.1新增）
+ * @param env 环境句柄
+ * @return 哈希值
+ */
+SNAKE_ENV_API uint64_t snake_env_hash(const SnakeEnv *env);
+
+/**
+ * @brief 渲染图像的尺寸和字节数（1.2新增）
+ * @param env 环境句柄
+ * @param scale 每个格子的边长（像素），至少为1
+ * @param format 像素格式（SnakeEnvPixelFormat）
+ * @param width 输出的图像宽度（像素），可为NULL
+ * @param height 输出的图像高度（像素），可为NULL
+ * @return 字节数，参数无效时返回0
+ */
+SNAKE_ENV_API size_t snake_env_render_size(const SnakeEnv *env, int32_t scale,
+                                           int32_t format, int32_t *width,
+                                           int32_t *height);
+
+/**
+ * @brief 在CPU上把当前局面渲染为图像（1.2新增）
+ *
+ * 与游戏窗口的布局和颜色一致，不需要OpenGL上下文，不同的环境可在多个线程中
+ * 并发渲染。图像自上而下逐行紧密存放。
+ *
+ * @param env 环境句柄
+ * @param pixels 输出缓冲，至少snake_env_render_size字节
+ * @param scale 每个格子的边长（像素），至少为1
+ * @param format 像素格式（SnakeEnvPixelFormat）
+ * @return 写入的字节数，参数无效时返回0且不写入
+ */
+SNAKE_ENV_API size_t snake_env_render(const SnakeEnv *env, uint8_t *pixels,
+                                      int32_t scale, int32_t format);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,124 @@
+#pragma once
+
+// 按列存储的轨迹数据集：每列一个文件，写入端通过mmap追加并按倍数预分配，
+// 读取端映射文件后按批遍历。方向和结束标志按位压缩，得分和长度按差分
+// + zigzag + varint编码，观测哈希和奖励按原始小端格式存放。
+// 写入器和读取器都不是线程安全的，多线程记录时每个线程使用独立的目录。
+// 仅支持POSIX系统。
+
+#include "env/snake_env.h"
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TRAJECTORY_MAGIC 0x4A52544Eu // "NTRJ"
+#define TRAJECTORY_VERSION 1
+
+// 数据列
+typedef enum {
+  TRAJECTORY_COLUMN_OBS_HASH, // uint64观测哈希
+  TRAJECTORY_COLUMN_ACTION,   // 2位方向
+  TRAJECTORY_COLUMN_REWARD,   // float奖励
+  TRAJECTORY_COLUMN_SCORE,    // 得分差分varint
+  TRAJECTORY_COLUMN_LENGTH,   // 长度差分varint
+  TRAJECTORY_COLUMN_DONE,     // 1位结束标志
+  TRAJECTORY_COLUMN_COUNT
+} TrajectoryColumn;
+
+// 单步记录
+typedef struct {
+  uint64_t obsHash; // 观测哈希
+  float reward;     // 奖励
+  int32_t score;    // 得分
+  int32_t length;   // 蛇长度
+  uint8_t action;   // 方向（0-3，与SnakeEnvAction一致）
+  uint8_t done;     // 本局是否结束
+} TrajectoryStep;
+
+// 一批记录。obsHashes和rewards直接指向映射的文件，其余列解码到读取器
+// 持有的缓冲中；在下一次调用trajectory_reader_next之前有效
+typedef struct {
+  size_t count;              // 本批行数
+  uint64_t firstRow;         // 本批第一行的行号
+  const uint64_t *obsHashes; // 观测哈希
+  const float *rewards;      // 奖励
+  const int32_t *scores;     // 得分
+  const int32_t *lengths;    // 蛇长度
+  const uint8_t *actions;    // 方向
+  const uint8_t *dones;      // 结束标志
+} TrajectoryBatch;
+
+typedef struct TrajectoryWriter TrajectoryWriter;
+typedef struct TrajectoryReader TrajectoryReader;
+
+/**
+ * @brief 创建数据集目录并打开写入器（已有的数据会被覆盖）
+ * @param directory 数据集目录
+ * @return 写入器，失败时返回NULL
+ */
+SNAKE_ENV_API TrajectoryWriter *trajectory_writer_open(const char *directory);
+
+/**
+ * @brief 追加一行记录
+ * @param writer 写入器
+ * @param step 记录
+ * @return 成功返回true，扩展文件失败时返回false
+ */
+SNAKE_ENV_API bool trajectory_writer_append(TrajectoryWriter *writer,
+                                            const TrajectoryStep *step);
+
+/**
+ * @brief 把当前行数和各列大小写入元数据文件，之后读取端可以看到已写入的行
+ * @param writer 写入器
+ * @return 成功返回true
+ */
+SNAKE_ENV_API bool trajectory_writer_flush(TrajectoryWriter *writer);
+
+/**
+ * @brief 写入元数据、截断预分配的空间并关闭写入器
+ * @param writer 写入器
+ */
+SNAKE_ENV_API void trajectory_writer_close(TrajectoryWriter *writer);
+
+/**
+ * @brief 映射数据集并打开读取器
+ * @param directory 数据集目录
+ * @param batchSize 每批最多的行数
+ * @return 读取器，失败时返回NULL
+ */
+SNAKE_ENV_API TrajectoryReader *trajectory_reader_open(const char *directory,
+                                                       size_t batchSize);
+
+/**
+ * @brief 数据集的总行数
+ * @param reader 读取器
+ * @return 行数
+ */
+SNAKE_ENV_API uint64_t trajectory_reader_rows(const TrajectoryReader *reader);
+
+/**
+ * @brief 读取下一批记录
+ * @param reader 读取器
+ * @param batch 输出的批
+ * @return 读到数据返回true，已到末尾或数据损坏时返回false
+ */
+SNAKE_ENV_API bool trajectory_reader_next(TrajectoryReader *reader,
+                                          TrajectoryBatch *batch);
+
+/**
+ * @brief 回到第一行
+ * @param reader 读取器
+ */
+SNAKE_ENV_API void trajectory_reader_rewind(TrajectoryReader *reader);
+
+/**
+ * @brief 关闭读取器并解除映射
+ * @param reader 读取器
+ */
+SNAKE_ENV_API void trajectory_reader_close(TrajectoryReader *reader);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,81 @@
+#pragma once
+#include "core/simulation.h"
+#include "scene/scene.h"
+#include <glad/glad.h>
+#include <stdint.h>
+
+// 像素缓冲对象环的长度，决定最多可以同时等待回读的帧数
+#define HEADLESS_PBO_COUNT 4
+
+/**
+ * @brief 离屏帧的像素格式
+ */
+typedef enum {
+  HEADLESS_FORMAT_RGBA, // 每像素4字节
+  HEADLESS_FORMAT_RGB,  // 每像素3字节
+} HeadlessPixelFormat;
+
+/**
+ * @brief 无窗口离屏渲染器（EGL上下文 + FBO + PBO异步回读）
+ */
+typedef struct {
+  void *display;                           // EGLDisplay
+  void *context;                           // EGLContext
+  void *surface;                           // EGLSurface，支持无表面上下文时为空
+  GLuint framebuffer;                      // 离屏帧缓冲
+  GLuint colorBuffer;                      // 颜色渲染缓冲
+  int width;                               // 帧宽度（像素）
+  int height;                              // 帧高度（像素）
+  HeadlessPixelFormat format;              // 像素格式
+  size_t frameSize;                        // 每帧字节数
+  GameScene scene;                         // 铺满帧缓冲的游戏场景
+  GLuint pixelBuffers[HEADLESS_PBO_COUNT]; // 回读用像素缓冲对象环
+  GLsync fences[HEADLESS_PBO_COUNT];       // 每个槽位的回读完成栅栏
+  uint64_t frameIds[HEADLESS_PBO_COUNT];   // 每个槽位对应的帧编号
+  int head;                                // 下一个写入的槽位
+  int pending;                             // 尚未取回的帧数
+  uint64_t nextFrameId;                    // 下一帧编号
+} HeadlessRenderer;
+
+/**
+ * @brief 创建无窗口的OpenGL上下文并初始化离屏渲染器
+ *
+ * @param renderer 渲染器指针
+ * @param width 帧宽度（像素）
+ * @param height 帧高度（像素）
+ * @param format 像素格式
+ * @param config 游戏配置（用于网格尺寸）
+ * @return int 成功返回1，失败返回0
+ */
+int init_headless_renderer(HeadlessRenderer *renderer, int width, int height,
+                           HeadlessPixelFormat format,
+                           const GameConfig *config);
+
+/**
+ * @brief 渲染一帧并发起异步回读（不等待GPU）
+ *
+ * @param renderer 渲染器指针
+ * @param snapshot 游戏快照
+ * @return uint64_t 帧编号；所有槽位都在等待回读时返回0
+ */
+uint64_t submit_headless_frame(HeadlessRenderer *renderer,
+                               const GameSnapshot *snapshot);
+
+/**
+ * @brief 取回最早提交的一帧像素（自上而下逐行存放）
+ *
+ * @param renderer 渲染器指针
+ * @param pixels 输出缓冲，至少frameSize字节
+ * @param frameId 返回的帧编号，可为NULL
+ * @param wait 该帧尚未完成时是否等待
+ * @return int 取回成功返回1，没有可取回的帧返回0
+ */
+int read_headless_frame(HeadlessRenderer *renderer, unsigned char *pixels,
+                        uint64_t *frameId, bool wait);
+
+/**
+ * @brief 释放离屏渲染器及其OpenGL上下文
+ *
+ * @param renderer 渲染器指针
+ */
+void cleanup_headless_renderer(HeadlessRenderer *renderer);
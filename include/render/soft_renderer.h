@@ -0,0 +1,56 @@
+#pragma once
+#include "core/food.h"
+#include "core/simulation.h"
+#include "core/snake.h"
+#include "core/state.h"
+#include <stddef.h>
+
+/**
+ * @brief 软件渲染的像素格式
+ */
+typedef enum {
+  SOFT_FORMAT_RGB,  // 每像素3字节
+  SOFT_FORMAT_GRAY, // 每像素1字节（亮度）
+} SoftPixelFormat;
+
+/**
+ * @brief 软件渲染目标（像素缓冲由调用者提供）
+ */
+typedef struct {
+  unsigned char *pixels;  // 像素缓冲，自上而下逐行存放
+  size_t pitch;           // 每行字节数，不小于宽度乘以每像素字节数
+  int cellScale;          // 每个格子的边长（像素）
+  SoftPixelFormat format; // 像素格式
+} SoftTarget;
+
+/**
+ * @brief 计算棋盘按指定格子边长渲染后的尺寸
+ *
+ * @param config 游戏配置
+ * @param cellScale 每个格子的边长（像素）
+ * @param width 返回的图像宽度（像素）
+ * @param height 返回的图像高度（像素）
+ */
+void soft_target_size(const GameConfig *config, int cellScale, int *width,
+                      int *height);
+
+/**
+ * @brief 在CPU上渲染棋盘（边界、贪吃蛇和食物），不需要OpenGL上下文，可在多个线程中并发调用
+ *
+ * @param target 渲染目标
+ * @param config 游戏配置
+ * @param snake 贪吃蛇
+ * @param foodManager 食物管理器
+ */
+void render_board_soft(const SoftTarget *target, const GameConfig *config,
+                       const Snake *snake, const FoodManager *foodManager);
+
+/**
+ * @brief 在CPU上渲染快照中的棋盘
+ *
+ * @param target 渲染目标
+ * @param config 游戏配置
+ * @param snapshot 游戏快照
+ */
+void render_snapshot_soft(const SoftTarget *target, const GameConfig *config,
+                          const GameSnapshot *snapshot);
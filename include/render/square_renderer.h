@@ -6,10 +6,12 @@
  * @brief 方格渲染器结构体
  */
 typedef struct {
-  GLuint shaderProgram;   // 着色器程序
-  GLuint VAO;             // 顶点数组对象
-  GLuint VBO;             // 顶点缓冲区对象
-  CoordinateSystem coord; // 坐标系统
+  GLuint shaderProgram;    // 着色器程序
+  GLuint VAO;              // 顶点数组对象
+  GLuint VBO;              // 顶点缓冲区对象
+  GLint colorLocation;     // color uniform位置
+  GLint transformLocation; // transform uniform位置
+  CoordinateSystem coord;  // 坐标系统
 } SquareRenderer;
 
 /**
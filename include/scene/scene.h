@@ -1,4 +1,5 @@
 #pragma once
+#include "core/simulation.h"
 #include "render/coordinate.h"
 #include "render/square_renderer.h"
 
@@ -27,6 +28,23 @@ typedef struct {
 int init_game_scene(GameScene *scene, int gridWidth, int gridHeight,
                     float gridSize, float gridColor[4]);
 
+/**
+ * @brief 按指定屏幕尺寸初始化游戏场景（用于离屏渲染）
+ *
+ * @param scene 场景指针
+ * @param gridWidth 网格宽度（格子数）
+ * @param gridHeight 网格高度（格子数）
+ * @param gridSize 每个格子的大小
+ * @param gridColor 网格颜色（RGBA）
+ * @param screenWidth 坐标系统使用的屏幕宽度
+ * @param screenHeight 坐标系统使用的屏幕高度
+ * @return int 成功返回1，失败返回0
+ */
+int init_game_scene_with_screen(GameScene *scene, int gridWidth,
+                                int gridHeight, float gridSize,
+                                float gridColor[4], int screenWidth,
+                                int screenHeight);
+
 /**
  * @brief 渲染游戏场景（包括网格）
  *
@@ -34,6 +52,16 @@ int init_game_scene(GameScene *scene, int gridWidth, int gridHeight,
  */
 void render_game_scene(GameScene *scene);
 
+/**
+ * @brief 渲染快照中的贪吃蛇和食物
+ *
+ * @param scene 场景指针
+ * @param snapshot 游戏快照
+ * @param alpha 蛇身插值因子（0为上一步位置，1为当前位置）
+ */
+void render_game_snapshot(GameScene *scene, const GameSnapshot *snapshot,
+                          float alpha);
+
 /**
  * @brief 清理游戏场景资源
  *
@@ -8,14 +8,18 @@
 typedef struct {
     char* key;
     char* value;
+    size_t hash;            // 键名哈希值
 } ini_entry_t;
 
 // INI节结构
 typedef struct {
     char* name;
+    size_t hash;            // 节名哈希值
     ini_entry_t* entries;
     size_t entry_count;
     size_t entry_capacity;
+    size_t* entry_index;    // 键哈希索引（开放寻址，槽内存放条目下标+1，0为空槽）
+    size_t index_capacity;  // 键索引槽数量（2的幂）
 } ini_section_t;
 
 // INI文件结构
@@ -23,6 +27,10 @@ typedef struct {
     ini_section_t* sections;
     size_t section_count;
     size_t section_capacity;
+    size_t* section_index;  // 节哈希索引（开放寻址，槽内存放节下标+1，0为空槽）
+    size_t index_capacity;  // 节索引槽数量（2的幂）
+    char* arena;            // 加载时所有节名、键、值共用的字符串块
+    size_t arena_size;      // 字符串块大小
 } ini_file_t;
 
 // 函数声明
@@ -35,6 +43,7 @@ ini_file_t* ini_create(void);
 
 /**
  * @brief 从文件加载INI配置
+ * @note 文件以内存映射方式读取，行长度不受限制；加载得到的字符串统一存放在一个arena中
  * @param filename 文件名
  * @return 加载的INI文件结构指针，失败返回NULL
  */
@@ -0,0 +1,58 @@
+#pragma once
+#include "render/background_effect.h"
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+
+/**
+ * @brief 可在运行时热重载的配置快照（发布后只读）
+ */
+typedef struct {
+  float moveInterval;                    // 移动间隔（秒）
+  bool vsync;                            // 垂直同步
+  BackgroundEffectType backgroundEffect; // 背景特效类型
+  float backgroundSpeed;                 // 背景动画速度
+  float backgroundIntensity;             // 背景特效强度
+} RuntimeConfig;
+
+/**
+ * @brief 配置文件监视器
+ */
+typedef struct {
+  char *path;             // 配置文件路径
+  SDL_Thread *thread;     // 后台监视线程
+  SDL_AtomicInt running;  // 监视线程运行标志
+  void *pending;          // 最新发布、尚未被渲染线程取走的快照
+  RuntimeConfig *current; // 渲染线程当前使用的快照
+} ConfigWatcher;
+
+/**
+ * @brief 从INI文件解析运行时配置
+ *
+ * @param path 配置文件路径
+ * @return RuntimeConfig* 新分配的快照，文件无法加载时返回NULL
+ */
+RuntimeConfig *load_runtime_config(const char *path);
+
+/**
+ * @brief 启动配置监视线程，并发布初始快照
+ *
+ * @param watcher 监视器指针
+ * @param path 配置文件路径
+ * @return int 成功返回1，失败返回0
+ */
+int start_config_watcher(ConfigWatcher *watcher, const char *path);
+
+/**
+ * @brief 取走最新发布的快照（只在渲染线程调用，不会阻塞）
+ *
+ * @param watcher 监视器指针
+ * @return const RuntimeConfig* 有新快照时返回该快照，否则返回NULL
+ */
+const RuntimeConfig *poll_config_update(ConfigWatcher *watcher);
+
+/**
+ * @brief 停止监视线程并释放所有快照
+ *
+ * @param watcher 监视器指针
+ */
+void stop_config_watcher(ConfigWatcher *watcher);
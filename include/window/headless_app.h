@@ -0,0 +1,67 @@
+#pragma once
+#include "core/pathfinding.h"
+#include "core/simulation.h"
+#include "render/headless.h"
+#include <SDL3/SDL.h>
+#include <stdio.h>
+
+// 启用离屏模式的命令行参数
+#define HEADLESS_APP_FLAG "--headless"
+// 每次SDL_AppIterate最多提交的帧数
+#define HEADLESS_APP_BATCH 256
+
+/**
+ * @brief 离屏模式：不创建窗口，游戏在主线程上逐步推进，每一步渲染一帧观测
+ *
+ * 由命令行参数HEADLESS_APP_FLAG或windows.ini的[headless] enabled启用，分辨率、
+ * 像素格式和帧数也在[headless]中配置。蛇沿最短路径去吃最近的食物，死亡后
+ * 立即开始新的一局。帧写入[headless] output指定的文件（原始像素，逐帧相连），
+ * 不指定时只统计帧率。
+ */
+typedef struct {
+  HeadlessRenderer renderer; // 离屏渲染器
+  Game game;                 // 游戏，不经过状态机直接步进
+  PathFinder finder;         // 驱动蛇的寻路器
+  GameSnapshot snapshot;     // 提交渲染的快照
+  unsigned char *pixels;     // 回读一帧的缓冲
+  FILE *output;              // 帧输出文件，NULL表示丢弃
+  uint64_t frameLimit;       // 总帧数，0表示直到退出
+  uint64_t submitted;        // 已提交的帧数
+  uint64_t completed;        // 已回读的帧数
+  Uint64 startTimeNS;        // 开始时间
+  Uint64 reportTimeNS;       // 上次输出帧率的时间
+  uint64_t reportFrames;     // 上次输出帧率时已回读的帧数
+} HeadlessApp;
+
+/**
+ * @brief 是否以离屏模式运行（命令行参数或配置文件）
+ *
+ * @param argc 参数个数
+ * @param argv 参数列表
+ * @return bool 启用离屏模式返回true
+ */
+bool is_headless_requested(int argc, char **argv);
+
+/**
+ * @brief 读取[headless]配置，创建离屏渲染器并开始第一局
+ *
+ * @param app 离屏模式指针（已清零）
+ * @param config 游戏配置
+ * @return int 成功返回1，失败返回0
+ */
+int init_headless_app(HeadlessApp *app, const GameConfig *config);
+
+/**
+ * @brief 推进并渲染一批帧，取回已完成的帧
+ *
+ * @param app 离屏模式指针
+ * @return bool 达到帧数上限时返回false
+ */
+bool iterate_headless_app(HeadlessApp *app);
+
+/**
+ * @brief 取回剩余的帧，输出总帧率并释放资源
+ *
+ * @param app 离屏模式指针
+ */
+void cleanup_headless_app(HeadlessApp *app);
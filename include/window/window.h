@@ -1,23 +1,27 @@
 
 #pragma once
-#include "core/food.h"
-#include "core/snake.h"
-#include "core/state.h"
+#include "core/simulation.h"
 #include "render/background_effect.h"
 #include "scene/scene.h"
+#include "window/config_watcher.h"
+#include "window/headless_app.h"
 #include <SDL3/SDL.h>
 
 #define SCREEN_WIDTH 1024
 #define SCREEN_HEIGHT 768
 
+// 窗口与运行时配置文件路径
+#define WINDOW_CONFIG_PATH "assets/config/windows.ini"
+
 typedef struct {
   SDL_Window *window;
+  SDL_GLContext glContext;          // OpenGL上下文
   GameScene *scene;                 // 游戏场景
-  GameStateData gameState;          // 游戏状态
-  Snake snake;                      // 贪吃蛇
-  FoodManager foodManager;          // 食物管理器
+  Simulation sim;                   // 游戏模拟（在独立线程上运行）
   BackgroundEffectManager bgEffect; // 背景特效管理器
+  ConfigWatcher configWatcher;      // 配置热重载监视器
   Uint64 lastFrameTime;             // 上一帧时间
+  HeadlessApp *headless;            // 离屏模式，窗口模式下为NULL
 } AppState;
 
 /**
@@ -27,6 +31,13 @@ typedef struct {
  */
 int init_app_meta_data();
 
+/**
+ * @brief 按配置文件[debug]节的simd选择SIMD内核的指令集
+ *
+ * 只在启动时调用一次，之后修改配置文件不会重新选择
+ */
+void init_simd_dispatch();
+
 /**
  * @brief 初始化OpenGL渲染
  *
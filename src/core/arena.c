@@ -0,0 +1,364 @@
+#include "core/arena.h"
+#include "core/food.h"
+#include "utils/memory.h"
+#include <string.h>
+
+// 与generate_food相同的随机尝试次数
+#define ARENA_FOOD_ATTEMPTS 100
+// 随机放置一条蛇的尝试次数
+#define ARENA_SPAWN_ATTEMPTS 100
+// 蛇身环形缓冲的最小容量
+#define ARENA_MIN_BODY_CAPACITY 8
+
+static const int deltaX[4] = {0, 0, -1, 1};
+static const int deltaY[4] = {-1, 1, 0, 0};
+
+static inline bool is_reverse(Direction a, Direction b) {
+  return ((int)a ^ 1) == (int)b;
+}
+
+static inline uint32_t snake_cell(int id) { return (uint32_t)id + 1; }
+
+static inline void set_cell(Arena *arena, ArenaCell cell, uint32_t value) {
+  set_sparse_cell(&arena->cells, cell.x, cell.y, value);
+}
+
+static inline uint32_t next_random(Arena *arena) {
+  return next_food_random(&arena->rngState);
+}
+
+static int round_up_power_of_two(int value) {
+  int result = 1;
+  while (result < value) {
+    result *= 2;
+  }
+  return result;
+}
+
+// ---------------- 食物 ----------------
+
+// 与generate_food相同先随机尝试；大网格上全部落空时不做逐格兜底（那是O(格子数)），
+// 留到下一步再补
+void replenish_arena_food(Arena *arena) {
+  const int width = arena->config.gridWidth;
+  const int height = arena->config.gridHeight;
+  reserve_sparse_chunks(&arena->cells,
+                        arena->config.maxFoodCount - arena->foodCount);
+  while (arena->foodCount < arena->config.maxFoodCount) {
+    bool placed = false;
+    for (int attempt = 0; attempt < ARENA_FOOD_ATTEMPTS && !placed;
+         attempt++) {
+      ArenaCell cell = {(int)(next_random(arena) % (uint32_t)width),
+                        (int)(next_random(arena) % (uint32_t)height)};
+      if (get_arena_cell(arena, cell.x, cell.y) == ARENA_CELL_EMPTY) {
+        set_cell(arena, cell, ARENA_CELL_FOOD);
+        arena->foodCount++;
+        placed = true;
+      }
+    }
+    if (!placed) {
+      return;
+    }
+  }
+}
+
+// ---------------- 蛇身 ----------------
+
+static inline ArenaCell tail_of(const ArenaSnake *snake) {
+  return snake->body[(snake->head + snake->length - 1) &
+                     (snake->capacity - 1)];
+}
+
+// 按从蛇头到蛇尾的顺序搬到容量翻倍的新缓冲
+static void grow_body(ArenaSnake *snake) {
+  const int capacity = snake->capacity * 2;
+  ArenaCell *body = NEW_ARRAY(ArenaCell, capacity);
+  for (int i = 0; i < snake->length; i++) {
+    body[i] = snake->body[(snake->head + i) & (snake->capacity - 1)];
+  }
+  FREE(snake->body);
+  snake->body = body;
+  snake->capacity = capacity;
+  snake->head = 0;
+}
+
+static inline void push_head(ArenaSnake *snake, ArenaCell cell) {
+  if (snake->length == snake->capacity) {
+    grow_body(snake);
+  }
+  snake->head = (snake->head - 1) & (snake->capacity - 1);
+  snake->body[snake->head] = cell;
+  snake->length++;
+}
+
+// 移除死亡的蛇在网格上的全部格子并释放蛇身，长度保留以便读取
+static void remove_snake(Arena *arena, ArenaSnake *snake) {
+  for (int i = 0; i < snake->length; i++) {
+    set_cell(arena, snake->body[(snake->head + i) & (snake->capacity - 1)],
+             ARENA_CELL_EMPTY);
+  }
+  FREE(snake->body);
+  snake->capacity = 0;
+}
+
+static void reserve_snakes(Arena *arena, int count) {
+  if (count <= arena->snakeCapacity) {
+    return;
+  }
+
+  int capacity = arena->snakeCapacity > 0 ? arena->snakeCapacity : 16;
+  while (capacity < count) {
+    capacity *= 2;
+  }
+  arena->snakes = (ArenaSnake *)REALLOC(arena->snakes,
+                                        sizeof(ArenaSnake) * capacity);
+  arena->alive = (int *)REALLOC(arena->alive, sizeof(int) * capacity);
+  FREE(arena->moves);
+  arena->moves = NEW_ARRAY(ArenaMove, capacity);
+  arena->snakeCapacity = capacity;
+}
+
+// ---------------- 迎头相撞 ----------------
+
+void reset_arena_claims(ArenaClaimTable *table, int count) {
+  // 散列表保持至少一半为空
+  if (table->capacity < count * 2) {
+    FREE(table->entries);
+    table->capacity = round_up_power_of_two(count * 2);
+    table->entries = NEW_ARRAY(ArenaClaim, table->capacity);
+  }
+  if (table->entries != NULL) {
+    memset(table->entries, 0, sizeof(ArenaClaim) * table->capacity);
+  }
+}
+
+void cleanup_arena_claims(ArenaClaimTable *table) {
+  FREE(table->entries);
+  table->capacity = 0;
+}
+
+static inline uint64_t claim_key(const Arena *arena, const ArenaMove *move) {
+  return arena_cell_index(arena, move->target.x, move->target.y) + 1;
+}
+
+static inline ArenaClaim *find_claim(const ArenaClaimTable *table,
+                                     uint64_t key) {
+  const uint64_t mask = (uint64_t)table->capacity - 1;
+  uint64_t slot = (key * 0x9E3779B97F4A7C15ULL >> 32) & mask;
+  while (table->entries[slot].key != 0 && table->entries[slot].key != key) {
+    slot = (slot + 1) & mask;
+  }
+  return &table->entries[slot];
+}
+
+// 保留最长者，一样长时标记为平局
+void claim_arena_target(ArenaClaimTable *table, const Arena *arena,
+                        const ArenaMove *move) {
+  const uint64_t key = claim_key(arena, move);
+  ArenaClaim *claim = find_claim(table, key);
+  if (claim->key == 0) {
+    claim->key = key;
+    claim->best = move->snake;
+    claim->length = move->length;
+    claim->tied = false;
+  } else if (move->length > claim->length) {
+    claim->best = move->snake;
+    claim->length = move->length;
+    claim->tied = false;
+  } else if (move->length == claim->length) {
+    claim->tied = true;
+  }
+}
+
+bool wins_arena_claim(const ArenaClaimTable *table, const Arena *arena,
+                      const ArenaMove *move) {
+  const ArenaClaim *claim = find_claim(table, claim_key(arena, move));
+  return claim->best == move->snake && !claim->tied;
+}
+
+// ---------------- 步进 ----------------
+
+void propose_arena_move(Arena *arena, int id, ArenaMove *move) {
+  ArenaSnake *snake = &arena->snakes[id];
+  if (!is_reverse(snake->nextDirection, snake->direction)) {
+    snake->direction = snake->nextDirection;
+  }
+
+  const ArenaCell head = get_arena_snake_head(snake);
+  move->snake = id;
+  move->length = snake->length;
+  move->target.x = head.x + deltaX[snake->direction];
+  move->target.y = head.y + deltaY[snake->direction];
+  move->eats = false;
+  move->death = ARENA_DEATH_NONE;
+  if (!arena_in_bounds(arena, move->target.x, move->target.y)) {
+    move->death = ARENA_DEATH_WALL;
+    return;
+  }
+
+  const uint32_t content = get_arena_cell(arena, move->target.x,
+                                          move->target.y);
+  if (content == ARENA_CELL_FOOD) {
+    move->eats = true;
+  } else if (content != ARENA_CELL_EMPTY) {
+    move->death = ARENA_DEATH_BODY;
+  }
+}
+
+// 新蛇头所在格子步进前为空或食物，且只有这条蛇进入；擦除的蛇尾和死亡的蛇身
+// 只属于这条蛇，因此各蛇的写入互不干扰，顺序无关
+bool apply_arena_move(Arena *arena, const ArenaMove *move) {
+  ArenaSnake *snake = &arena->snakes[move->snake];
+  if (move->death != ARENA_DEATH_NONE) {
+    snake->death = move->death;
+    remove_snake(arena, snake);
+    return false;
+  }
+
+  // 与step_game一样，吃到食物的下一步才增长
+  if (!snake->grow) {
+    set_cell(arena, tail_of(snake), ARENA_CELL_EMPTY);
+    snake->length--;
+  }
+  snake->grow = move->eats;
+  snake->score += move->eats;
+  push_head(snake, move->target);
+  set_cell(arena, move->target, snake_cell(move->snake));
+  return move->eats;
+}
+
+// 按原顺序保留存活的蛇
+void prune_arena_snakes(Arena *arena) {
+  int count = 0;
+  for (int i = 0; i < arena->aliveCount; i++) {
+    const int id = arena->alive[i];
+    if (arena->snakes[id].death == ARENA_DEATH_NONE) {
+      arena->alive[count++] = id;
+    }
+  }
+  arena->aliveCount = count;
+}
+
+int step_arena(Arena *arena) {
+  // 只遍历存活列表，开销与加入过的蛇的总数无关
+  const int moveCount = arena->aliveCount;
+  for (int i = 0; i < moveCount; i++) {
+    propose_arena_move(arena, arena->alive[i], &arena->moves[i]);
+  }
+
+  // 裁决阶段：先登记全部目标，再判定迎头相撞
+  reset_arena_claims(&arena->claims, moveCount);
+  for (int i = 0; i < moveCount; i++) {
+    if (arena->moves[i].death == ARENA_DEATH_NONE) {
+      claim_arena_target(&arena->claims, arena, &arena->moves[i]);
+    }
+  }
+  for (int i = 0; i < moveCount; i++) {
+    ArenaMove *move = &arena->moves[i];
+    if (move->death == ARENA_DEATH_NONE &&
+        !wins_arena_claim(&arena->claims, arena, move)) {
+      move->death = ARENA_DEATH_HEAD_ON;
+    }
+  }
+
+  // 每个提议最多让蛇头进入一个新分块
+  reserve_sparse_chunks(&arena->cells, moveCount);
+  int deaths = 0;
+  for (int i = 0; i < moveCount; i++) {
+    arena->foodCount -= apply_arena_move(arena, &arena->moves[i]);
+    deaths += arena->moves[i].death != ARENA_DEATH_NONE;
+  }
+
+  prune_arena_snakes(arena);
+  arena->tickCount++;
+  replenish_arena_food(arena);
+  compact_sparse_grid(&arena->cells);
+  return deaths;
+}
+
+// ---------------- 初始化 ----------------
+
+void init_arena(Arena *arena, const GameConfig *config, GridLayoutKind layout,
+                uint64_t seed) {
+  memset(arena, 0, sizeof(*arena));
+  arena->config = *config;
+  arena->rngState = seed;
+  init_sparse_grid(&arena->cells, config->gridWidth, config->gridHeight,
+                   layout);
+  reserve_snakes(arena, 1);
+  replenish_arena_food(arena);
+}
+
+void cleanup_arena(Arena *arena) {
+  for (int i = 0; i < arena->snakeCount; i++) {
+    FREE(arena->snakes[i].body);
+  }
+  FREE(arena->snakes);
+  FREE(arena->alive);
+  FREE(arena->moves);
+  cleanup_arena_claims(&arena->claims);
+  cleanup_sparse_grid(&arena->cells);
+  arena->snakeCount = 0;
+  arena->snakeCapacity = 0;
+  arena->aliveCount = 0;
+}
+
+int add_arena_snake(Arena *arena, int x, int y, Direction direction,
+                    int length) {
+  if (length < 1) {
+    return -1;
+  }
+  // 蛇身向方向的反方向伸展，全部格子必须在网格内且为空
+  for (int i = 0; i < length; i++) {
+    int cellX = x - deltaX[direction] * i;
+    int cellY = y - deltaY[direction] * i;
+    if (!arena_in_bounds(arena, cellX, cellY) ||
+        get_arena_cell(arena, cellX, cellY) != ARENA_CELL_EMPTY) {
+      return -1;
+    }
+  }
+
+  reserve_snakes(arena, arena->snakeCount + 1);
+  reserve_sparse_chunks(&arena->cells, length);
+  const int id = arena->snakeCount++;
+  ArenaSnake *snake = &arena->snakes[id];
+  memset(snake, 0, sizeof(*snake));
+  snake->capacity = round_up_power_of_two(
+      length > ARENA_MIN_BODY_CAPACITY ? length : ARENA_MIN_BODY_CAPACITY);
+  snake->body = NEW_ARRAY(ArenaCell, snake->capacity);
+  snake->direction = direction;
+  snake->nextDirection = direction;
+  snake->death = ARENA_DEATH_NONE;
+
+  // 从蛇尾开始依次压入，最后压入的是蛇头
+  for (int i = length - 1; i >= 0; i--) {
+    ArenaCell cell = {x - deltaX[direction] * i, y - deltaY[direction] * i};
+    push_head(snake, cell);
+    set_cell(arena, cell, snake_cell(id));
+  }
+  arena->alive[arena->aliveCount++] = id;
+  return id;
+}
+
+int spawn_arena_snake(Arena *arena) {
+  const int width = arena->config.gridWidth;
+  const int height = arena->config.gridHeight;
+  for (int attempt = 0; attempt < ARENA_SPAWN_ATTEMPTS; attempt++) {
+    int x = (int)(next_random(arena) % (uint32_t)width);
+    int y = (int)(next_random(arena) % (uint32_t)height);
+    Direction direction = (Direction)(next_random(arena) % 4);
+    int id = add_arena_snake(arena, x, y, direction,
+                             arena->config.initialSnakeLength);
+    if (id >= 0) {
+      return id;
+    }
+  }
+  return -1;
+}
+
+void steer_arena_snake(Arena *arena, int id, Direction direction) {
+  if (id >= 0 && id < arena->snakeCount &&
+      arena->snakes[id].death == ARENA_DEATH_NONE) {
+    arena->snakes[id].nextDirection = direction;
+  }
+}
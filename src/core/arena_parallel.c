@@ -0,0 +1,302 @@
+#include "core/arena_parallel.h"
+#include "utils/memory.h"
+
+// 分块：蛇头在块内的蛇，以及本步与块相关的提议
+struct ArenaTile {
+  int *snakes;            // 蛇头在块内的存活的蛇
+  int snakeCount;         // 蛇数
+  int snakeCapacity;      // snakes的容量
+  ArenaMove *moves;       // 本块的蛇目标在块内或已判定死亡的提议
+  int moveCount;          // 提议数
+  int moveCapacity;       // moves的容量
+  ArenaMove *outgoing;    // 本块的蛇目标在其他分块的提议
+  int outgoingCount;      // 出站提议数
+  int outgoingCapacity;   // outgoing的容量
+  ArenaMove *incoming;    // 其他分块的蛇目标在本块的提议
+  int incomingCount;      // 入站提议数
+  int incomingCapacity;   // incoming的容量
+  ArenaClaimTable claims; // 目标在本块的迎头相撞散列表
+  int deaths;             // 本步死亡的蛇数
+  int eaten;              // 本步吃掉的食物数
+};
+
+// 常驻工作线程
+struct ArenaWorker {
+  ArenaStepper *stepper;
+  SDL_Semaphore *start; // 调用线程发出信号后执行stepper->phase
+  SDL_Thread *thread;
+};
+
+// 容量不足count时按2倍扩大，返回（可能移动后的）数组
+static void *reserve_array(void *items, int *capacity, int count,
+                           size_t size) {
+  if (count <= *capacity) {
+    return items;
+  }
+  int expanded = *capacity > 0 ? *capacity : 16;
+  while (expanded < count) {
+    expanded *= 2;
+  }
+  *capacity = expanded;
+  return REALLOC(items, size * expanded);
+}
+
+static inline int tile_index(const ArenaStepper *stepper, ArenaCell cell) {
+  return (cell.y >> stepper->tileShift) * stepper->tilesX +
+         (cell.x >> stepper->tileShift);
+}
+
+static inline int tile_count(const ArenaStepper *stepper) {
+  return stepper->tilesX * stepper->tilesY;
+}
+
+// ---------------- 分块列表 ----------------
+
+static void assign_snake(ArenaStepper *stepper, int id) {
+  const ArenaSnake *snake = &stepper->arena->snakes[id];
+  ArenaTile *tile =
+      &stepper->tiles[tile_index(stepper, get_arena_snake_head(snake))];
+  tile->snakes = reserve_array(tile->snakes, &tile->snakeCapacity,
+                               tile->snakeCount + 1, sizeof(int));
+  tile->snakes[tile->snakeCount++] = id;
+}
+
+// 归入新加入的蛇；竞技场在别处步进过时分块列表已过期，按存活列表全部重建
+static void sync_tiles(ArenaStepper *stepper) {
+  const Arena *arena = stepper->arena;
+  if (stepper->knownTick != arena->tickCount) {
+    for (int t = 0; t < tile_count(stepper); t++) {
+      stepper->tiles[t].snakeCount = 0;
+    }
+    for (int i = 0; i < arena->aliveCount; i++) {
+      assign_snake(stepper, arena->alive[i]);
+    }
+    stepper->knownSnakes = arena->snakeCount;
+    stepper->knownTick = arena->tickCount;
+  }
+  // 新加入的蛇在下一次步进前都是存活的
+  for (int id = stepper->knownSnakes; id < arena->snakeCount; id++) {
+    assign_snake(stepper, id);
+  }
+  stepper->knownSnakes = arena->snakeCount;
+}
+
+// ---------------- 各阶段 ----------------
+
+static void propose_tile(ArenaStepper *stepper, ArenaTile *tile, int index) {
+  tile->moveCount = 0;
+  tile->outgoingCount = 0;
+  tile->incomingCount = 0;
+  if (tile->snakeCount == 0) {
+    return;
+  }
+
+  tile->moves = reserve_array(tile->moves, &tile->moveCapacity,
+                              tile->snakeCount, sizeof(ArenaMove));
+  tile->outgoing = reserve_array(tile->outgoing, &tile->outgoingCapacity,
+                                 tile->snakeCount, sizeof(ArenaMove));
+  for (int i = 0; i < tile->snakeCount; i++) {
+    ArenaMove move;
+    propose_arena_move(stepper->arena, tile->snakes[i], &move);
+    if (move.death != ARENA_DEATH_NONE ||
+        tile_index(stepper, move.target) == index) {
+      tile->moves[tile->moveCount++] = move;
+    } else {
+      tile->outgoing[tile->outgoingCount++] = move;
+    }
+  }
+}
+
+// 按分块顺序转交出站提议，只在调用线程中执行；顺便为裁决阶段预留网格分块，
+// 每个提议最多让蛇头进入一个新分块
+static void merge_outgoing(ArenaStepper *stepper) {
+  int moveCount = 0;
+  for (int t = 0; t < tile_count(stepper); t++) {
+    const ArenaTile *source = &stepper->tiles[t];
+    moveCount += source->moveCount + source->outgoingCount;
+    for (int i = 0; i < source->outgoingCount; i++) {
+      const ArenaMove *move = &source->outgoing[i];
+      ArenaTile *target = &stepper->tiles[tile_index(stepper, move->target)];
+      target->incoming =
+          reserve_array(target->incoming, &target->incomingCapacity,
+                        target->incomingCount + 1, sizeof(ArenaMove));
+      target->incoming[target->incomingCount++] = *move;
+    }
+  }
+  reserve_sparse_chunks(&stepper->arena->cells, moveCount);
+}
+
+static void claim_moves(const ArenaStepper *stepper, ArenaTile *tile,
+                        const ArenaMove *moves, int count) {
+  for (int i = 0; i < count; i++) {
+    if (moves[i].death == ARENA_DEATH_NONE) {
+      claim_arena_target(&tile->claims, stepper->arena, &moves[i]);
+    }
+  }
+}
+
+// 判定迎头相撞后执行，存活的蛇新蛇头都在本块，追加到本块的蛇列表
+static void settle_moves(ArenaStepper *stepper, ArenaTile *tile,
+                         ArenaMove *moves, int count) {
+  for (int i = 0; i < count; i++) {
+    ArenaMove *move = &moves[i];
+    if (move->death == ARENA_DEATH_NONE &&
+        !wins_arena_claim(&tile->claims, stepper->arena, move)) {
+      move->death = ARENA_DEATH_HEAD_ON;
+    }
+    tile->eaten += apply_arena_move(stepper->arena, move);
+    if (move->death != ARENA_DEATH_NONE) {
+      tile->deaths++;
+    } else {
+      tile->snakes[tile->snakeCount++] = move->snake;
+    }
+  }
+}
+
+static void resolve_tile(ArenaStepper *stepper, ArenaTile *tile) {
+  // 旧的蛇列表在提议阶段之后不再需要，这里就地重建
+  tile->snakeCount = 0;
+  tile->deaths = 0;
+  tile->eaten = 0;
+  const int total = tile->moveCount + tile->incomingCount;
+  if (total == 0) {
+    return;
+  }
+
+  // 全部登记完才能判定，同一格子的提议可能分别来自本块和入站列表
+  reset_arena_claims(&tile->claims, total);
+  claim_moves(stepper, tile, tile->moves, tile->moveCount);
+  claim_moves(stepper, tile, tile->incoming, tile->incomingCount);
+
+  tile->snakes = reserve_array(tile->snakes, &tile->snakeCapacity, total,
+                               sizeof(int));
+  settle_moves(stepper, tile, tile->moves, tile->moveCount);
+  settle_moves(stepper, tile, tile->incoming, tile->incomingCount);
+}
+
+// ---------------- 工作线程 ----------------
+
+// 各线程从同一个计数器领取分块，直到全部领完
+static void run_phase(ArenaStepper *stepper) {
+  const int count = tile_count(stepper);
+  int t;
+  while ((t = SDL_AddAtomicInt(&stepper->nextTile, 1)) < count) {
+    if (stepper->phase == ARENA_PHASE_PROPOSE) {
+      propose_tile(stepper, &stepper->tiles[t], t);
+    } else {
+      resolve_tile(stepper, &stepper->tiles[t]);
+    }
+  }
+}
+
+static int arena_worker_thread(void *data) {
+  ArenaWorker *worker = (ArenaWorker *)data;
+  ArenaStepper *stepper = worker->stepper;
+  while (true) {
+    SDL_WaitSemaphore(worker->start);
+    if (stepper->phase == ARENA_PHASE_QUIT) {
+      return 0;
+    }
+    run_phase(stepper);
+    SDL_SignalSemaphore(stepper->done);
+  }
+}
+
+// 信号量的发出与等待保证了阶段之间数据的可见性
+static void run_parallel(ArenaStepper *stepper, ArenaPhase phase) {
+  stepper->phase = phase;
+  SDL_SetAtomicInt(&stepper->nextTile, 0);
+  for (int i = 0; i < stepper->workerCount; i++) {
+    SDL_SignalSemaphore(stepper->workers[i].start);
+  }
+  run_phase(stepper);
+  for (int i = 0; i < stepper->workerCount; i++) {
+    SDL_WaitSemaphore(stepper->done);
+  }
+}
+
+// ---------------- 接口 ----------------
+
+void init_arena_stepper(ArenaStepper *stepper, Arena *arena, int threadCount,
+                        int tileSize) {
+  memset(stepper, 0, sizeof(*stepper));
+  stepper->arena = arena;
+  stepper->threadCount =
+      threadCount > 0 ? threadCount : SDL_GetNumLogicalCPUCores();
+  while ((1 << stepper->tileShift) < tileSize && stepper->tileShift < 30) {
+    stepper->tileShift++;
+  }
+  const int size = 1 << stepper->tileShift;
+  stepper->tilesX = (arena->config.gridWidth + size - 1) / size;
+  stepper->tilesY = (arena->config.gridHeight + size - 1) / size;
+  stepper->tiles = NEW_ARRAY_ZEROED(ArenaTile, tile_count(stepper));
+  stepper->knownTick = arena->tickCount;
+
+  stepper->done = SDL_CreateSemaphore(0);
+  stepper->workers = NEW_ARRAY(ArenaWorker, stepper->threadCount);
+  // 线程创建失败时由其余线程领取全部分块
+  for (int i = 1; i < stepper->threadCount && stepper->done != NULL; i++) {
+    ArenaWorker *worker = &stepper->workers[stepper->workerCount];
+    worker->stepper = stepper;
+    worker->start = SDL_CreateSemaphore(0);
+    worker->thread =
+        worker->start != NULL
+            ? SDL_CreateThread(arena_worker_thread, "arena", worker)
+            : NULL;
+    if (worker->thread == NULL) {
+      SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "创建竞技场线程失败: %s",
+                  SDL_GetError());
+      SDL_DestroySemaphore(worker->start);
+      continue;
+    }
+    stepper->workerCount++;
+  }
+}
+
+void cleanup_arena_stepper(ArenaStepper *stepper) {
+  stepper->phase = ARENA_PHASE_QUIT;
+  for (int i = 0; i < stepper->workerCount; i++) {
+    SDL_SignalSemaphore(stepper->workers[i].start);
+  }
+  for (int i = 0; i < stepper->workerCount; i++) {
+    SDL_WaitThread(stepper->workers[i].thread, NULL);
+    SDL_DestroySemaphore(stepper->workers[i].start);
+  }
+  if (stepper->done != NULL) {
+    SDL_DestroySemaphore(stepper->done);
+    stepper->done = NULL;
+  }
+  FREE(stepper->workers);
+  stepper->workerCount = 0;
+
+  for (int t = 0; t < tile_count(stepper) && stepper->tiles != NULL; t++) {
+    ArenaTile *tile = &stepper->tiles[t];
+    FREE(tile->snakes);
+    FREE(tile->moves);
+    FREE(tile->outgoing);
+    FREE(tile->incoming);
+    cleanup_arena_claims(&tile->claims);
+  }
+  FREE(stepper->tiles);
+}
+
+int step_arena_parallel(ArenaStepper *stepper) {
+  Arena *arena = stepper->arena;
+  sync_tiles(stepper);
+
+  run_parallel(stepper, ARENA_PHASE_PROPOSE);
+  merge_outgoing(stepper);
+  run_parallel(stepper, ARENA_PHASE_RESOLVE);
+
+  int deaths = 0;
+  for (int t = 0; t < tile_count(stepper); t++) {
+    deaths += stepper->tiles[t].deaths;
+    arena->foodCount -= stepper->tiles[t].eaten;
+  }
+  prune_arena_snakes(arena);
+  arena->tickCount++;
+  replenish_arena_food(arena);
+  compact_sparse_grid(&arena->cells);
+  stepper->knownTick = arena->tickCount;
+  return deaths;
+}
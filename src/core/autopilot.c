@@ -0,0 +1,305 @@
+#include "core/autopilot.h"
+#include "utils/memory.h"
+#include <SDL3/SDL.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// 回路缓存文件
+#define CYCLE_FILE_MAGIC 0x4C435948u // "HYCL"
+#define CYCLE_FILE_VERSION 1u
+
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  int32_t width;
+  int32_t height;
+} CycleFileHeader;
+
+// 缓存文件路径的最大长度
+#define CYCLE_PATH_MAX 4096
+
+// 捷径之后到蛇尾至少保留的格子数（另按食物数增加），给随后的增长留出空间
+#define SHORTCUT_TAIL_MARGIN 3
+
+static inline int forward_distance(const HamiltonAutopilot *pilot, int from,
+                                   int to) {
+  int distance = to - from;
+  return distance < 0 ? distance + pilot->cellCount : distance;
+}
+
+static inline bool cells_adjacent(int width, int a, int b) {
+  int ax = a % width, ay = a / width;
+  int bx = b % width, by = b / width;
+  return abs(ax - bx) + abs(ay - by) == 1;
+}
+
+/**
+ * 按行蛇形生成回路（要求高度为偶数）：第0列留作返回通道，各行在第1列到最后一列之间
+ * 来回穿行，最后一行结束后沿第0列回到起点。transpose为true时按列生成（要求宽度为偶数）
+ */
+static void build_cycle(HamiltonAutopilot *pilot, bool transpose) {
+  const int width = pilot->gridWidth;
+  const int major = transpose ? pilot->gridWidth : pilot->gridHeight;
+  const int minor = transpose ? pilot->gridHeight : pilot->gridWidth;
+#define CYCLE_CELL(m, n) (transpose ? (n) * width + (m) : (m) * width + (n))
+
+  int index = 0;
+  for (int m = 0; m < major; m++) {
+    for (int i = 1; i < minor; i++) {
+      int n = (m % 2 == 0) ? i : minor - i;
+      pilot->cells[index++] = CYCLE_CELL(m, n);
+    }
+  }
+  for (int m = major - 1; m >= 0; m--) {
+    pilot->cells[index++] = CYCLE_CELL(m, 0);
+  }
+#undef CYCLE_CELL
+}
+
+// 检查cells是否是一条合法的回路，并填好order
+static bool index_cycle(HamiltonAutopilot *pilot) {
+  for (int i = 0; i < pilot->cellCount; i++) {
+    pilot->order[i] = -1;
+  }
+
+  for (int i = 0; i < pilot->cellCount; i++) {
+    int cell = pilot->cells[i];
+    int next = pilot->cells[(i + 1) % pilot->cellCount];
+    if (cell < 0 || cell >= pilot->cellCount || pilot->order[cell] >= 0 ||
+        !cells_adjacent(pilot->gridWidth, cell, next)) {
+      return false;
+    }
+    pilot->order[cell] = i;
+  }
+  return true;
+}
+
+static bool cycle_cache_path(char *path, const char *directory, int width,
+                             int height) {
+  int length = snprintf(path, CYCLE_PATH_MAX, "%s/hamilton_%dx%d.bin",
+                        directory, width, height);
+  return length > 0 && length < CYCLE_PATH_MAX;
+}
+
+static bool load_cycle(HamiltonAutopilot *pilot, const char *path) {
+  FILE *file = fopen(path, "rb");
+  if (file == NULL) {
+    return false;
+  }
+
+  CycleFileHeader header;
+  bool ok = fread(&header, sizeof(header), 1, file) == 1 &&
+            header.magic == CYCLE_FILE_MAGIC &&
+            header.version == CYCLE_FILE_VERSION &&
+            header.width == pilot->gridWidth &&
+            header.height == pilot->gridHeight;
+  for (int i = 0; ok && i < pilot->cellCount; i++) {
+    int32_t cell;
+    ok = fread(&cell, sizeof(cell), 1, file) == 1;
+    pilot->cells[i] = cell;
+  }
+  fclose(file);
+
+  // 文件可以被替换为外部生成的回路，读入后必须重新校验
+  return ok && index_cycle(pilot);
+}
+
+static bool save_cycle(const HamiltonAutopilot *pilot, const char *path) {
+  char temp[CYCLE_PATH_MAX + 8];
+  snprintf(temp, sizeof(temp), "%s.tmp", path);
+
+  // 先写临时文件再重命名，并发启动的进程不会读到写了一半的回路
+  FILE *file = fopen(temp, "wb");
+  if (file == NULL) {
+    return false;
+  }
+  CycleFileHeader header = {CYCLE_FILE_MAGIC, CYCLE_FILE_VERSION,
+                            pilot->gridWidth, pilot->gridHeight};
+  bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+  for (int i = 0; ok && i < pilot->cellCount; i++) {
+    int32_t cell = pilot->cells[i];
+    ok = fwrite(&cell, sizeof(cell), 1, file) == 1;
+  }
+  ok = fclose(file) == 0 && ok;
+  if (!ok) {
+    remove(temp);
+    return false;
+  }
+
+  if (rename(temp, path) != 0) {
+    // Windows上目标已存在时rename失败
+    remove(path);
+    if (rename(temp, path) != 0) {
+      remove(temp);
+      return false;
+    }
+  }
+  return true;
+}
+
+bool init_hamilton_autopilot(HamiltonAutopilot *pilot, int gridWidth,
+                             int gridHeight, const char *cacheDirectory) {
+  pilot->cells = NULL;
+  pilot->order = NULL;
+  // 网格是二分图，格子数为奇数时不存在哈密顿回路
+  if (gridWidth < 2 || gridHeight < 2 ||
+      (gridWidth % 2 != 0 && gridHeight % 2 != 0)) {
+    return false;
+  }
+
+  pilot->gridWidth = gridWidth;
+  pilot->gridHeight = gridHeight;
+  pilot->cellCount = gridWidth * gridHeight;
+  pilot->cells = NEW_ARRAY(int, pilot->cellCount);
+  pilot->order = NEW_ARRAY(int, pilot->cellCount);
+
+  char path[CYCLE_PATH_MAX];
+  bool cached = cacheDirectory != NULL &&
+                cycle_cache_path(path, cacheDirectory, gridWidth, gridHeight);
+  if (cached && load_cycle(pilot, path)) {
+    return true;
+  }
+
+  build_cycle(pilot, gridHeight % 2 != 0);
+  index_cycle(pilot);
+  if (cached && !save_cycle(pilot, path)) {
+    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "无法写入回路缓存: %s", path);
+  }
+  return true;
+}
+
+void cleanup_hamilton_autopilot(HamiltonAutopilot *pilot) {
+  FREE(pilot->cells);
+  FREE(pilot->order);
+}
+
+// 从蛇头往蛇尾，各节落后蛇头的回路距离必须严格递增
+static bool body_follows_cycle(const HamiltonAutopilot *pilot,
+                               const Snake *snake) {
+  const int width = pilot->gridWidth;
+  int head = -1;
+  int last = 0;
+  const KNode *node;
+  knode_for_each(node, &snake->head) {
+    const SnakeSegment *segment = container_of(node, SnakeSegment, node);
+    if (segment->x < 0 || segment->x >= width || segment->y < 0 ||
+        segment->y >= pilot->gridHeight) {
+      return false;
+    }
+    int order = pilot->order[segment->y * width + segment->x];
+    if (head < 0) {
+      head = order;
+      continue;
+    }
+    int behind = forward_distance(pilot, order, head);
+    if (behind <= last) {
+      return false;
+    }
+    last = behind;
+  }
+  return head >= 0;
+}
+
+// 反转回路方向
+static void reverse_cycle(HamiltonAutopilot *pilot) {
+  for (int i = 0, j = pilot->cellCount - 1; i < j; i++, j--) {
+    int cell = pilot->cells[i];
+    pilot->cells[i] = pilot->cells[j];
+    pilot->cells[j] = cell;
+  }
+  for (int i = 0; i < pilot->cellCount; i++) {
+    pilot->order[pilot->cells[i]] = i;
+  }
+}
+
+// 回路上的下一格不能在当前方向的正后方，否则change_direction忽略这次转向。
+// 只有一节的蛇沿两个方向都能排列，要靠这一条选出能走的方向
+static bool next_cell_allowed(const HamiltonAutopilot *pilot,
+                              const Game *game) {
+  static const int deltaX[4] = {0, 0, -1, 1};
+  static const int deltaY[4] = {-1, 1, 0, 0};
+  const int width = pilot->gridWidth;
+  int headX, headY;
+  get_snake_head(&game->snake, &headX, &headY);
+  int order = pilot->order[headY * width + headX];
+  int next = pilot->cells[(order + 1) % pilot->cellCount];
+  const Direction direction = game->state.currentDirection;
+  return next % width != headX - deltaX[direction] ||
+         next / width != headY - deltaY[direction];
+}
+
+static bool snake_fits_cycle(const HamiltonAutopilot *pilot,
+                             const Game *game) {
+  return body_follows_cycle(pilot, &game->snake) &&
+         next_cell_allowed(pilot, game);
+}
+
+bool sync_hamilton_autopilot(HamiltonAutopilot *pilot, const Game *game) {
+  if (snake_fits_cycle(pilot, game)) {
+    return true;
+  }
+  reverse_cycle(pilot);
+  return snake_fits_cycle(pilot, game);
+}
+
+void drive_hamilton_autopilot(const HamiltonAutopilot *pilot, Game *game) {
+  const Snake *snake = &game->snake;
+  if (knode_empty(&snake->head)) {
+    return;
+  }
+
+  const int width = pilot->gridWidth;
+  int headX, headY;
+  get_snake_head(snake, &headX, &headY);
+  const SnakeSegment *tail = container_of(snake->head.prev, SnakeSegment, node);
+  const int head = pilot->order[headY * width + headX];
+  const int tailDistance =
+      forward_distance(pilot, head, pilot->order[tail->y * width + tail->x]);
+
+  // 回路上最近的食物；蛇头所在的食物本步被吃掉，不算目标
+  int foodDistance = pilot->cellCount;
+  const KNode *node;
+  knode_for_each(node, &game->foodManager.head) {
+    const Food *food = container_of(node, Food, node);
+    int distance =
+        forward_distance(pilot, head, pilot->order[food->y * width + food->x]);
+    if (distance > 0 && distance < foodDistance) {
+      foodDistance = distance;
+    }
+  }
+
+  // 捷径不越过食物，并且跳过之后与蛇尾之间留有余量。跳过的格子要等蛇尾走过
+  // 之后才回到蛇头前方，在此之前每吃一个食物，蛇头与蛇尾的距离就少一格；食物
+  // 越多吃得越快，所以余量按食物数增加，并且只在蛇身短于棋盘的
+  // 1/(2×食物数)时走捷径，之后只沿回路前进，让蛇尾在食物密集之前走过空隙
+  const int foodCount = game->foodManager.maxCount;
+  int maxJump = 1;
+  if (snake->length * 2 * foodCount < pilot->cellCount) {
+    maxJump = tailDistance - 1 - SHORTCUT_TAIL_MARGIN - foodCount;
+    if (check_food_at_position(&game->foodManager, headX, headY) != NULL) {
+      maxJump--; // 本步增长，蛇尾不动
+    }
+    if (maxJump > foodDistance) {
+      maxJump = foodDistance;
+    }
+  }
+
+  static const int deltaX[4] = {0, 0, -1, 1};
+  static const int deltaY[4] = {-1, 1, 0, 0};
+  Direction best = DIRECTION_RIGHT;
+  int bestJump = 0;
+  for (int k = 0; k < 4; k++) {
+    int x = headX + deltaX[k];
+    int y = headY + deltaY[k];
+    if (x < 0 || x >= width || y < 0 || y >= pilot->gridHeight) {
+      continue;
+    }
+    // 回路上的下一格总是可选的；更远的格子在蛇头与蛇尾之间，必然为空
+    int jump = forward_distance(pilot, head, pilot->order[y * width + x]);
+    if (jump > bestJump && (jump == 1 || jump <= maxJump)) {
+      best = (Direction)k;
+      bestJump = jump;
+    }
+  }
+  change_direction(&game->state, best);
+}
@@ -0,0 +1,237 @@
+#include "core/bitboard.h"
+#include <string.h>
+
+// 泛洪填充的工作区：上下各有一行全零的哨兵，扫描时无需边界判断
+typedef struct {
+  int height;
+  uint64_t open[BITBOARD_MAX_SIZE + 2];   // 可通行格子
+  uint64_t region[BITBOARD_MAX_SIZE + 2]; // 已到达的格子
+} FloodFill;
+
+static inline uint64_t row_mask(int width) {
+  return width >= 64 ? ~0ULL : (1ULL << width) - 1;
+}
+
+// 在一行的连续可通行段内，把起点向两侧扩展到段的两端
+static inline uint64_t fill_row(uint64_t seed, uint64_t open) {
+  // 向高位：加法的进位从每段第一个起点一直传到段尾
+  uint64_t filled = seed | (((open + seed) ^ open) & open);
+  // 向低位：倍增移位（Kogge-Stone）；门控链与填充链互不依赖，可并行执行
+  uint64_t gate = open;
+  for (int shift = 1; shift < 64; shift <<= 1) {
+    filled |= gate & (filled >> shift);
+    gate &= gate >> shift;
+  }
+  return filled;
+}
+
+static void init_flood_fill(FloodFill *fill, const Bitboard *open) {
+  fill->height = open->height;
+  fill->open[0] = 0;
+  memcpy(fill->open + 1, open->rows, sizeof(uint64_t) * open->height);
+  fill->open[open->height + 1] = 0;
+}
+
+// 清空已到达的格子
+static void clear_flood_region(FloodFill *fill) {
+  memset(fill->region, 0, sizeof(uint64_t) * (fill->height + 2));
+}
+
+// 加入第y行的起点（必须在open内），并立即在行内扩展
+static void seed_flood_row(FloodFill *fill, int y, uint64_t seed) {
+  const int row = y + 1;
+  fill->region[row] = fill_row(fill->region[row] | seed, fill->open[row]);
+}
+
+/**
+ * 第y行并入相邻的from行已到达的格子后在行内扩展，没有新格子时跳过扩展。
+ * 返回第y行中与from行未到达的可通行格子相邻的格子，非零时需要反向再扫一遍
+ */
+static inline uint64_t absorb_row(FloodFill *fill, int y, int from) {
+  const uint64_t previous = fill->region[from];
+  uint64_t current = fill->region[y];
+  const uint64_t seed = previous & fill->open[y];
+  if (seed & ~current) {
+    current = fill_row(current | seed, fill->open[y]);
+    fill->region[y] = current;
+  }
+  return current & fill->open[from] & ~previous;
+}
+
+// 沿一个方向扫描一遍
+static bool sweep_flood(FloodFill *fill, bool downward) {
+  const int step = downward ? 1 : -1;
+  uint64_t leaked = 0;
+  int y = downward ? 1 : fill->height;
+  for (int i = 0; i < fill->height; i++, y += step) {
+    leaked |= absorb_row(fill, y, y - step);
+  }
+  return leaked != 0;
+}
+
+// 从第y行同时向上、向下扫描，两条依赖链交错执行
+static bool sweep_flood_outward(FloodFill *fill, int y) {
+  const int row = y + 1;
+  uint64_t leaked = 0;
+  for (int i = 1; row + i <= fill->height || row - i >= 1; i++) {
+    if (row + i <= fill->height) {
+      leaked |= absorb_row(fill, row + i, row + i - 1);
+    }
+    if (row - i >= 1) {
+      leaked |= absorb_row(fill, row - i, row - i + 1);
+    }
+  }
+  return leaked != 0;
+}
+
+// 交替上下扫描，直到某一遍没有格子漏回已扫过的行
+static void run_flood_fill(FloodFill *fill, bool converged) {
+  bool downward = true;
+  while (!converged) {
+    converged = !sweep_flood(fill, downward);
+    downward = !downward;
+  }
+}
+
+static int flood_region_count(const FloodFill *fill) {
+  int count = 0;
+  for (int y = 1; y <= fill->height; y++) {
+    count += __builtin_popcountll(fill->region[y]);
+  }
+  return count;
+}
+
+bool init_bitboard(Bitboard *board, int width, int height) {
+  if (width < 1 || width > BITBOARD_MAX_SIZE || height < 1 ||
+      height > BITBOARD_MAX_SIZE) {
+    return false;
+  }
+
+  board->width = width;
+  board->height = height;
+  memset(board->rows, 0, sizeof(board->rows));
+  return true;
+}
+
+bool build_free_bitboard(Bitboard *board, const GameConfig *config,
+                         const Snake *snake) {
+  if (!init_bitboard(board, config->gridWidth, config->gridHeight)) {
+    return false;
+  }
+
+  const uint64_t mask = row_mask(board->width);
+  for (int y = 0; y < board->height; y++) {
+    board->rows[y] = mask;
+  }
+
+  const KNode *node;
+  knode_for_each(node, &snake->head) {
+    const SnakeSegment *segment = container_of(node, SnakeSegment, node);
+    if (segment->x >= 0 && segment->x < board->width && segment->y >= 0 &&
+        segment->y < board->height) {
+      board->rows[segment->y] &= ~(1ULL << segment->x);
+    }
+  }
+  return true;
+}
+
+int bitboard_count(const Bitboard *board) {
+  int count = 0;
+  for (int y = 0; y < board->height; y++) {
+    count += __builtin_popcountll(board->rows[y]);
+  }
+  return count;
+}
+
+void bitboard_flood_fill(const Bitboard *open, Bitboard *region) {
+  FloodFill fill;
+  init_flood_fill(&fill, open);
+  clear_flood_region(&fill);
+  for (int y = 0; y < open->height; y++) {
+    seed_flood_row(&fill, y, region->rows[y] & open->rows[y]);
+  }
+
+  run_flood_fill(&fill, false);
+
+  region->width = open->width;
+  region->height = open->height;
+  memcpy(region->rows, fill.region + 1, sizeof(uint64_t) * open->height);
+}
+
+int bitboard_reachable_area(const Bitboard *open, int x, int y) {
+  if (x < 0 || x >= open->width || y < 0 || y >= open->height ||
+      !bitboard_test(open, x, y)) {
+    return 0;
+  }
+
+  FloodFill fill;
+  init_flood_fill(&fill, open);
+  clear_flood_region(&fill);
+  seed_flood_row(&fill, y, 1ULL << x);
+  run_flood_fill(&fill, !sweep_flood_outward(&fill, y));
+  return flood_region_count(&fill);
+}
+
+bool evaluate_move_safety(const Game *game, MoveSafety safety[4]) {
+  const Snake *snake = &game->snake;
+  if (knode_empty(&snake->head)) {
+    return false;
+  }
+
+  // 移动前的占用决定是否致死，与move_snake中的碰撞检查一致
+  Bitboard open;
+  if (!build_free_bitboard(&open, &game->state.config, snake)) {
+    return false;
+  }
+
+  int headX, headY;
+  get_snake_head(snake, &headX, &headY);
+
+  static const int deltaX[4] = {0, 0, -1, 1};
+  static const int deltaY[4] = {-1, 1, 0, 0};
+  int moveX[4], moveY[4];
+  bool alive[4];
+  for (int k = 0; k < 4; k++) {
+    moveX[k] = headX + deltaX[k];
+    moveY[k] = headY + deltaY[k];
+    alive[k] = moveX[k] >= 0 && moveX[k] < open.width && moveY[k] >= 0 &&
+               moveY[k] < open.height &&
+               bitboard_test(&open, moveX[k], moveY[k]);
+    safety[k].area = -1;
+    safety[k].cut = true;
+  }
+
+  // 蛇头在食物上时本步增长，蛇尾不动；否则蛇尾在移动后空出
+  if (check_food_at_position(&game->foodManager, headX, headY) == NULL) {
+    const SnakeSegment *tail =
+        container_of(snake->head.prev, SnakeSegment, node);
+    if (tail->x >= 0 && tail->x < open.width && tail->y >= 0 &&
+        tail->y < open.height) {
+      bitboard_set(&open, tail->x, tail->y);
+    }
+  }
+
+  // 新蛇头本身是起点，不阻挡从它出发的填充，因此四个候选共用同一张可通行棋盘；
+  // 落在同一连通区域内的候选面积相同，通常一次填充就能得到全部结果
+  FloodFill fill;
+  init_flood_fill(&fill, &open);
+  const int freeCells = bitboard_count(&open) - 1;
+  for (int k = 0; k < 4; k++) {
+    if (!alive[k] || safety[k].area >= 0) {
+      continue;
+    }
+
+    clear_flood_region(&fill);
+    seed_flood_row(&fill, moveY[k], 1ULL << moveX[k]);
+    run_flood_fill(&fill, !sweep_flood_outward(&fill, moveY[k]));
+
+    const int area = flood_region_count(&fill) - 1;
+    for (int j = k; j < 4; j++) {
+      if (alive[j] && ((fill.region[moveY[j] + 1] >> moveX[j]) & 1)) {
+        safety[j].area = area;
+        safety[j].cut = area < freeCells;
+      }
+    }
+  }
+  return true;
+}
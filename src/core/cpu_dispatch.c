@@ -0,0 +1,150 @@
+#include "core/cpu_dispatch.h"
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CPU_DISPATCH_X86 1
+#include <cpuid.h>
+#endif
+
+// 尚未初始化（不会与任何特性组合相同）
+#define CPU_FEATURES_UNSET UINT32_MAX
+
+// 各级别包含的特性：BMI2与AVX2同时出现（Haswell起），归入avx2级别
+static const struct {
+  const char *name;
+  uint32_t features;
+} cpuLevels[] = {
+    {"scalar", 0},
+    {"sse2", CPU_FEATURE_SSE2},
+    {"sse4.2", CPU_FEATURE_SSE2 | CPU_FEATURE_SSE42},
+    {"avx2", CPU_FEATURE_SSE2 | CPU_FEATURE_SSE42 | CPU_FEATURE_AVX2 |
+                 CPU_FEATURE_BMI2},
+    {"avx512", CPU_FEATURE_SSE2 | CPU_FEATURE_SSE42 | CPU_FEATURE_AVX2 |
+                   CPU_FEATURE_BMI2 | CPU_FEATURE_AVX512},
+};
+
+static uint32_t activeFeatures = CPU_FEATURES_UNSET;
+
+#ifdef CPU_DISPATCH_X86
+static uint64_t read_xcr0(void) {
+  uint32_t eax, edx;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return ((uint64_t)edx << 32) | eax;
+}
+#endif
+
+uint32_t detect_cpu_features(void) {
+  uint32_t features = 0;
+#ifdef CPU_DISPATCH_X86
+  unsigned int eax, ebx, ecx, edx;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+    return 0;
+  }
+  if (edx & bit_SSE2) {
+    features |= CPU_FEATURE_SSE2;
+  }
+  if (ecx & bit_SSE4_2) {
+    features |= CPU_FEATURE_SSE42;
+  }
+
+  // 只有操作系统在上下文切换时保存了对应的寄存器，AVX指令才能使用
+  uint64_t xcr0 = (ecx & bit_OSXSAVE) ? read_xcr0() : 0;
+  const bool ymm = (xcr0 & 0x06) == 0x06;        // XMM、YMM
+  const bool zmm = ymm && (xcr0 & 0xE0) == 0xE0; // opmask、ZMM高半部分
+  if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+    return features;
+  }
+  if (ebx & bit_BMI2) {
+    features |= CPU_FEATURE_BMI2;
+  }
+  if (ymm && (ebx & bit_AVX2)) {
+    features |= CPU_FEATURE_AVX2;
+  }
+  const unsigned int avx512 = bit_AVX512F | bit_AVX512BW | bit_AVX512VL;
+  if (zmm && (ebx & avx512) == avx512) {
+    features |= CPU_FEATURE_AVX512;
+  }
+#endif
+  return features;
+}
+
+static bool parse_cpu_level(const char *level, uint32_t *features) {
+  for (size_t i = 0; i < sizeof(cpuLevels) / sizeof(cpuLevels[0]); i++) {
+    if (strcmp(level, cpuLevels[i].name) == 0) {
+      *features = cpuLevels[i].features;
+      return true;
+    }
+  }
+  return false;
+}
+
+static void describe_features(uint32_t features, char *text, size_t size) {
+  snprintf(text, size, "%s%s%s%s%s%s", features ? "" : " scalar",
+           (features & CPU_FEATURE_SSE2) ? " sse2" : "",
+           (features & CPU_FEATURE_SSE42) ? " sse4.2" : "",
+           (features & CPU_FEATURE_AVX2) ? " avx2" : "",
+           (features & CPU_FEATURE_AVX512) ? " avx512" : "",
+           (features & CPU_FEATURE_BMI2) ? " bmi2" : "");
+}
+
+void init_cpu_dispatch(const char *level) {
+  const char *forced = SDL_getenv(CPU_DISPATCH_ENV);
+  if (forced != NULL && forced[0] != '\0') {
+    level = forced;
+  }
+
+  const uint32_t detected = detect_cpu_features();
+  uint32_t features = detected;
+  uint32_t allowed;
+  if (level != NULL && level[0] != '\0' && strcmp(level, "auto") != 0) {
+    if (parse_cpu_level(level, &allowed)) {
+      features &= allowed;
+    } else {
+      SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
+                  "未知的指令集级别: %s，自动选择", level);
+    }
+  }
+
+  uint32_t expected = CPU_FEATURES_UNSET;
+  if (!__atomic_compare_exchange_n(&activeFeatures, &expected, features,
+                                   false, __ATOMIC_ACQ_REL,
+                                   __ATOMIC_ACQUIRE)) {
+    return; // 已经初始化，内核可能已经绑定，不再更改
+  }
+
+  char text[64];
+  describe_features(features, text, sizeof(text));
+  if (features != detected) {
+    char supported[64];
+    describe_features(detected, supported, sizeof(supported));
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "SIMD指令集:%s（CPU支持:%s）",
+                text, supported);
+  } else {
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "SIMD指令集:%s", text);
+  }
+}
+
+uint32_t get_cpu_features(void) {
+  uint32_t features = __atomic_load_n(&activeFeatures, __ATOMIC_ACQUIRE);
+  if (features == CPU_FEATURES_UNSET) {
+    init_cpu_dispatch(NULL);
+    features = __atomic_load_n(&activeFeatures, __ATOMIC_ACQUIRE);
+  }
+  return features;
+}
+
+const void *select_cpu_kernels(const char *family,
+                               const CpuKernelVariant *variants, int count) {
+  const uint32_t features = get_cpu_features();
+  for (int i = 0; i < count; i++) {
+    if (variants[i].kernels != NULL &&
+        (variants[i].required & features) == variants[i].required) {
+      SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "%s内核: %s", family,
+                  variants[i].name);
+      return variants[i].kernels;
+    }
+  }
+  return NULL;
+}
@@ -1,7 +1,8 @@
 #include "core/food.h"
 #include "core/snake.h"
+#include "core/step_rules.h"
+#include "core/zobrist.h"
 #include "utils/memory.h"
-#include <stdlib.h>
 #include <time.h>
 
 void init_food_manager(FoodManager *manager, int maxCount) {
@@ -13,9 +14,26 @@ void init_food_manager(FoodManager *manager, int maxCount) {
   knode_init(&manager->head);
   manager->count = 0;
   manager->maxCount = maxCount;
+  manager->hash = 0;
 
   // 初始化随机数种子
-  srand((unsigned int)time(NULL));
+  seed_food_manager(manager, (uint64_t)time(NULL));
+}
+
+void seed_food_manager(FoodManager *manager, uint64_t seed) {
+  if (manager == NULL) {
+    return;
+  }
+
+  manager->rngState = seed;
+}
+
+// splitmix64：状态只在管理器内部，多个游戏可在不同线程中并发生成食物
+uint32_t next_food_random(uint64_t *rngState) {
+  uint64_t z = (*rngState += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return (uint32_t)((z ^ (z >> 31)) >> 32);
 }
 
 void cleanup_food_manager(FoodManager *manager) {
@@ -32,63 +50,111 @@ void cleanup_food_manager(FoodManager *manager) {
   }
 
   manager->count = 0;
+  manager->hash = 0;
 }
 
-bool generate_food(FoodManager *manager, int gridWidth, int gridHeight,
-                   const void *snake) {
-  if (manager == NULL || manager->count >= manager->maxCount) {
+// 在(x, y)放置一个食物
+static bool add_food(FoodManager *manager, int x, int y) {
+  Food *food = (Food *)MALLOC(sizeof(Food));
+  if (food == NULL) {
     return false;
   }
 
-  const Snake *snakePtr = (const Snake *)snake;
-
-  // 尝试生成食物的最大尝试次数
-  const int maxAttempts = 100;
-  int attempts = 0;
-
-  while (attempts < maxAttempts) {
-    // 生成随机位置
-    int x = rand() % gridWidth;
-    int y = rand() % gridHeight;
-
-    // 检查位置是否有效（不在蛇身上，且没有其他食物）
-    bool positionValid = true;
+  // 手动初始化节点，避免宏中的return语句
+  food->node.next = &food->node;
+  food->node.prev = &food->node;
+  food->x = x;
+  food->y = y;
+  food->value = 1; // 默认每个食物得1分
+
+  // 添加到链表
+  knode_add(&food->node, &manager->head);
+  manager->count++;
+  manager->hash ^= zobrist_cell_key(x, y, ZOBRIST_FOOD);
+  return true;
+}
 
-    // 检查是否在蛇身上
-    if (snakePtr != NULL && check_snake_collision(snakePtr, x, y)) {
-      positionValid = false;
-    }
+// 放置食物的上下文
+typedef struct {
+  FoodManager *manager;
+  const Snake *snake;
+  int gridWidth;
+  int gridHeight;
+  unsigned char *occupied; // 兜底时的占用表，由count_free建立
+} FoodSpawn;
+
+static bool spawn_is_free(StepContext context, int x, int y) {
+  const FoodSpawn *spawn = (const FoodSpawn *)context;
+  return !(spawn->snake != NULL && check_snake_collision(spawn->snake, x, y)) &&
+         check_food_at_position(spawn->manager, x, y) == NULL;
+}
 
-    // 检查是否已有食物
-    if (positionValid && check_food_at_position(manager, x, y) != NULL) {
-      positionValid = false;
+static int spawn_count_free(StepContext context) {
+  FoodSpawn *spawn = (FoodSpawn *)context;
+  const int gridWidth = spawn->gridWidth;
+  const int gridHeight = spawn->gridHeight;
+  const int cellCount = gridWidth * gridHeight;
+  unsigned char *occupied = NEW_ARRAY_ZEROED(unsigned char, cellCount);
+  int freeCells = cellCount;
+
+  const KNode *node;
+  if (spawn->snake != NULL) {
+    knode_for_each(node, &spawn->snake->head) {
+      const SnakeSegment *segment = container_of(node, SnakeSegment, node);
+      if (segment->x >= 0 && segment->x < gridWidth && segment->y >= 0 &&
+          segment->y < gridHeight) {
+        int cell = segment->y * gridWidth + segment->x;
+        freeCells -= !occupied[cell];
+        occupied[cell] = 1;
+      }
     }
+  }
+  knode_for_each(node, &spawn->manager->head) {
+    const Food *food = container_of(node, Food, node);
+    int cell = food->y * gridWidth + food->x;
+    freeCells -= !occupied[cell];
+    occupied[cell] = 1;
+  }
 
-    if (positionValid) {
-      // 创建新食物
-      Food *food = (Food *)MALLOC(sizeof(Food));
-      if (food == NULL) {
-        return false;
-      }
+  spawn->occupied = occupied;
+  return freeCells;
+}
 
-      // 手动初始化节点，避免宏中的return语句
-      food->node.next = &food->node;
-      food->node.prev = &food->node;
-      food->x = x;
-      food->y = y;
-      food->value = 1; // 默认每个食物得1分
+static void spawn_find_free(StepContext context, int pick, int *x, int *y) {
+  const FoodSpawn *spawn = (const FoodSpawn *)context;
+  const int cellCount = spawn->gridWidth * spawn->gridHeight;
+  for (int cell = 0; cell < cellCount; cell++) {
+    if (!spawn->occupied[cell] && pick-- == 0) {
+      *x = cell % spawn->gridWidth;
+      *y = cell / spawn->gridWidth;
+      return;
+    }
+  }
+}
 
-      // 添加到链表
-      knode_add(&food->node, &manager->head);
-      manager->count++;
+static void spawn_add_food(StepContext context, int x, int y) {
+  add_food(((FoodSpawn *)context)->manager, x, y);
+}
 
-      return true;
-    }
+static const FoodSpawnRules foodSpawnRules = {
+    spawn_is_free,
+    spawn_count_free,
+    spawn_find_free,
+    spawn_add_food,
+};
 
-    attempts++;
+bool generate_food(FoodManager *manager, int gridWidth, int gridHeight,
+                   const void *snake) {
+  if (manager == NULL || manager->count >= manager->maxCount) {
+    return false;
   }
 
-  return false;
+  FoodSpawn spawn = {manager, (const Snake *)snake, gridWidth, gridHeight,
+                     NULL};
+  bool added = place_food_by_rules(&foodSpawnRules, &spawn, gridWidth,
+                                   gridHeight, &manager->rngState);
+  FREE(spawn.occupied);
+  return added;
 }
 
 Food *check_food_at_position(const FoodManager *manager, int x, int y) {
@@ -113,6 +179,7 @@ int remove_food(FoodManager *manager, Food *food) {
   }
 
   int value = food->value;
+  manager->hash ^= zobrist_cell_key(food->x, food->y, ZOBRIST_FOOD);
 
   // 从链表中移除
   knode_del(&food->node);
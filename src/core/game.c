@@ -0,0 +1,261 @@
+#include "core/game.h"
+#include "core/step_rules.h"
+#include "core/zobrist.h"
+#include <SDL3/SDL.h>
+
+// 状态前置声明（转换表需要互相引用）
+static const State menuState;
+static const State playingState;
+static const State pausedState;
+static const State gameOverState;
+
+// 消费命令：命令存在时清除并返回true
+static bool consume_command(Game *game, GameCommand command) {
+  if ((game->commands & command) == 0) {
+    return false;
+  }
+  game->commands &= ~(unsigned int)command;
+  return true;
+}
+
+// ---------------- 转换条件 ----------------
+
+static bool on_action(FSM *fsm, FSMContext context) {
+  (void)fsm;
+  return consume_command((Game *)context, GAME_COMMAND_ACTION);
+}
+
+static bool on_restart(FSM *fsm, FSMContext context) {
+  (void)fsm;
+  return consume_command((Game *)context, GAME_COMMAND_RESTART);
+}
+
+static bool on_snake_dead(FSM *fsm, FSMContext context) {
+  (void)fsm;
+  return !((Game *)context)->snake.isAlive;
+}
+
+// ---------------- 状态回调 ----------------
+
+static void menu_enter(FSM *fsm, FSMContext context) {
+  Game *game = (Game *)context;
+  // 初次进入时蛇和食物刚初始化，无需重建
+  if (FSM_GetPreviousState(fsm) != NULL) {
+    reset_game_board(game);
+  }
+  reset_game(&game->state);
+}
+
+static void playing_enter(FSM *fsm, FSMContext context) {
+  Game *game = (Game *)context;
+  if (FSM_GetPreviousState(fsm) == &pausedState) {
+    resume_game(&game->state);
+  } else {
+    start_game(&game->state);
+  }
+}
+
+static void playing_update(FSM *fsm, FSMContext context, float deltaTime) {
+  (void)fsm;
+  Game *game = (Game *)context;
+  // 只有游戏中才推进计时和逻辑步进，其他状态没有更新回调
+  if (update_game_state(&game->state, deltaTime)) {
+    step_game(game);
+  }
+}
+
+static void paused_enter(FSM *fsm, FSMContext context) {
+  (void)fsm;
+  pause_game(&((Game *)context)->state);
+}
+
+static void game_over_enter(FSM *fsm, FSMContext context) {
+  (void)fsm;
+  game_over(&((Game *)context)->state);
+}
+
+// ---------------- 状态转换表 ----------------
+
+static const Transition menuTransitions[] = {
+    {&playingState, on_action},
+};
+
+static const Transition playingTransitions[] = {
+    {&gameOverState, on_snake_dead},
+    {&pausedState, on_action},
+};
+
+static const Transition pausedTransitions[] = {
+    {&playingState, on_action},
+};
+
+static const Transition gameOverTransitions[] = {
+    {&menuState, on_restart},
+};
+
+#define TRANSITION_COUNT(table) ((uint8_t)(sizeof(table) / sizeof((table)[0])))
+
+static const State menuState = {"menu", menu_enter, NULL, NULL,
+                                menuTransitions,
+                                TRANSITION_COUNT(menuTransitions)};
+
+static const State playingState = {"playing", playing_enter, playing_update,
+                                   NULL, playingTransitions,
+                                   TRANSITION_COUNT(playingTransitions)};
+
+static const State pausedState = {"paused", paused_enter, NULL, NULL,
+                                  pausedTransitions,
+                                  TRANSITION_COUNT(pausedTransitions)};
+
+static const State gameOverState = {"game_over", game_over_enter, NULL, NULL,
+                                    gameOverTransitions,
+                                    TRANSITION_COUNT(gameOverTransitions)};
+
+// ---------------- 逻辑步进的回调 ----------------
+
+static bool game_has_food(StepContext context, int x, int y) {
+  return check_food_at_position(&((Game *)context)->foodManager, x, y) != NULL;
+}
+
+static bool game_is_occupied(StepContext context, int x, int y) {
+  return check_snake_collision(&((Game *)context)->snake, x, y);
+}
+
+static void game_advance(StepContext context, int x, int y, bool grow) {
+  advance_snake(&((Game *)context)->snake, x, y, grow);
+}
+
+static int game_eat_food(StepContext context, int x, int y) {
+  FoodManager *manager = &((Game *)context)->foodManager;
+  return remove_food(manager, check_food_at_position(manager, x, y));
+}
+
+static void game_spawn_food(StepContext context) {
+  Game *game = (Game *)context;
+  const GameConfig *config = &game->state.config;
+  generate_food(&game->foodManager, config->gridWidth, config->gridHeight,
+                &game->snake);
+}
+
+static const StepRules gameStepRules = {
+    game_has_food, game_is_occupied, game_advance, game_eat_food,
+    game_spawn_food,
+};
+
+// ---------------- 对外接口 ----------------
+
+void init_game(Game *game, const GameConfig *config) {
+  if (game == NULL || config == NULL) {
+    return;
+  }
+
+  init_game_state(&game->state, config);
+
+  // 初始化贪吃蛇
+  int startX = config->gridWidth / 2;
+  int startY = config->gridHeight / 2;
+  init_snake(&game->snake, startX, startY, config->initialSnakeLength);
+
+  // 初始化食物管理器并生成初始食物
+  init_food_manager(&game->foodManager, config->maxFoodCount);
+  generate_food(&game->foodManager, config->gridWidth, config->gridHeight,
+                &game->snake);
+
+  game->commands = GAME_COMMAND_NONE;
+
+  FSM_Init(&game->fsm, &menuState, game);
+  FSM_Start(&game->fsm);
+}
+
+void cleanup_game(Game *game) {
+  // 未初始化或已清理的游戏无需处理
+  if (game == NULL || !FSM_IsRunning(&game->fsm)) {
+    return;
+  }
+
+  FSM_Stop(&game->fsm);
+  cleanup_snake(&game->snake);
+  cleanup_food_manager(&game->foodManager);
+}
+
+void update_game(Game *game, float deltaTime) {
+  if (game == NULL) {
+    return;
+  }
+
+  FSM_Update(&game->fsm, deltaTime);
+
+  // 当前状态不关心的命令直接丢弃，避免在之后的状态中误触发
+  game->commands = GAME_COMMAND_NONE;
+}
+
+void send_game_command(Game *game, GameCommand command) {
+  if (game == NULL) {
+    return;
+  }
+  game->commands |= (unsigned int)command;
+}
+
+bool step_game(Game *game) {
+  if (!game->snake.isAlive) {
+    return false;
+  }
+
+  // 规则与搜索局面共用；蛇死亡时由状态机转入游戏结束
+  const GameConfig *config = &game->state.config;
+  int headX, headY;
+  get_snake_head(&game->snake, &headX, &headY);
+  bool alive = step_by_rules(&gameStepRules, game, headX, headY,
+                             game->state.currentDirection, config->gridWidth,
+                             config->gridHeight, &game->state.score);
+  if (!alive) {
+    game->snake.isAlive = false;
+  }
+  return alive;
+}
+
+void reset_game_board(Game *game) {
+  if (game == NULL) {
+    return;
+  }
+
+  const GameConfig *config = &game->state.config;
+
+  // 重新初始化蛇并清空食物；食物管理器不重新初始化，保留随机数状态
+  cleanup_snake(&game->snake);
+  cleanup_food_manager(&game->foodManager);
+
+  int startX = config->gridWidth / 2;
+  int startY = config->gridHeight / 2;
+  init_snake(&game->snake, startX, startY, config->initialSnakeLength);
+  generate_food(&game->foodManager, config->gridWidth, config->gridHeight,
+                &game->snake);
+}
+
+uint64_t game_hash(const Game *game) {
+  return game->snake.hash ^ game->foodManager.hash ^
+         zobrist_direction_key(game->state.currentDirection) ^
+         zobrist_score_key(game->state.score);
+}
+
+uint64_t compute_game_hash(const Game *game) {
+  uint64_t hash = zobrist_direction_key(game->state.currentDirection) ^
+                  zobrist_score_key(game->state.score);
+
+  // 蛇头之后的每一节都带上指向前一节的方向
+  const SnakeSegment *previous = NULL;
+  const KNode *node;
+  knode_for_each(node, &game->snake.head) {
+    const SnakeSegment *segment = container_of(node, SnakeSegment, node);
+    hash ^= previous == NULL
+                ? zobrist_cell_key(segment->x, segment->y, ZOBRIST_HEAD)
+                : zobrist_body_key(segment->x, segment->y, previous->x,
+                                   previous->y);
+    previous = segment;
+  }
+  knode_for_each(node, &game->foodManager.head) {
+    const Food *food = container_of(node, Food, node);
+    hash ^= zobrist_cell_key(food->x, food->y, ZOBRIST_FOOD);
+  }
+  return hash;
+}
@@ -0,0 +1,124 @@
+#include "core/grid_layout.h"
+#include "core/cpu_dispatch.h"
+
+// ---------------- 编码和解码 ----------------
+
+static uint32_t encode_portable(const GridLayout *layout, uint32_t x,
+                                uint32_t y) {
+  return encode_grid_cell_portable(layout, x, y);
+}
+
+static void decode_portable(const GridLayout *layout, uint32_t index, int *x,
+                            int *y) {
+  const uint32_t interleaved = (1u << (2 * layout->lowBits)) - 1;
+  const uint32_t low = index & interleaved;
+  const uint32_t high = index & ~interleaved;
+  const uint32_t xHigh = (high & layout->xMask) >> layout->xHighShift;
+  const uint32_t yHigh = (high & layout->yMask) >> layout->yHighShift;
+  *x = (int)(compact_grid_bits(low) | (xHigh << layout->lowBits));
+  *y = (int)(compact_grid_bits(low >> 1) | (yHigh << layout->lowBits));
+}
+
+static const GridLayoutCodec portableCodec = {encode_portable,
+                                              decode_portable};
+const GridLayoutCodec *const gridLayoutCodecPortable = &portableCodec;
+
+// 第一次建立非行优先的排列时按CPU选择一次
+static const GridLayoutCodec *codec = NULL;
+
+static const GridLayoutCodec *select_codec(void) {
+  const GridLayoutCodec *selected = __atomic_load_n(&codec, __ATOMIC_ACQUIRE);
+  if (selected != NULL) {
+    return selected;
+  }
+  // 按优先顺序排列
+  const CpuKernelVariant variants[] = {
+      {"bmi2", CPU_FEATURE_BMI2, gridLayoutCodecBmi2},
+      {"portable", 0, gridLayoutCodecPortable},
+  };
+  selected = select_cpu_kernels("网格排列", variants,
+                                sizeof(variants) / sizeof(variants[0]));
+  __atomic_store_n(&codec, selected, __ATOMIC_RELEASE);
+  return selected;
+}
+
+// ---------------- 排列 ----------------
+
+// 表示0..count - 1所需的位数
+static int bits_for(uint64_t count) {
+  int bits = 0;
+  while (((uint64_t)1 << bits) < count) {
+    bits++;
+  }
+  return bits;
+}
+
+bool init_grid_layout(GridLayout *layout, GridLayoutKind kind, int width,
+                      int height) {
+  layout->kind = kind;
+  layout->width = width;
+  layout->height = height;
+  layout->lowBits = 0;
+  layout->xHighShift = 0;
+  layout->yHighShift = 0;
+  layout->xMask = 0;
+  layout->yMask = 0;
+  layout->codec = gridLayoutCodecPortable;
+
+  const int xBits = bits_for((uint64_t)width);
+  const int yBits = bits_for((uint64_t)height);
+  uint64_t cellCount = 0;
+  switch (kind) {
+  case GRID_LAYOUT_MORTON:
+    // 较长一轴的高位接在交错部分的上面，两轴一样长时y占有剩余的高位
+    layout->lowBits = xBits < yBits ? xBits : yBits;
+    layout->xHighShift = 2 * layout->lowBits;
+    layout->yHighShift = 2 * layout->lowBits;
+    cellCount = (uint64_t)1 << (xBits + yBits);
+    break;
+  case GRID_LAYOUT_TILED: {
+    // 块内交错，块的列号在其上，块的行号在最上面
+    const int tileXBits = bits_for(
+        ((uint64_t)width + (1u << GRID_TILE_SHIFT) - 1) >> GRID_TILE_SHIFT);
+    const uint64_t tileRows =
+        ((uint64_t)height + (1u << GRID_TILE_SHIFT) - 1) >> GRID_TILE_SHIFT;
+    layout->lowBits = GRID_TILE_SHIFT;
+    layout->xHighShift = 2 * GRID_TILE_SHIFT;
+    layout->yHighShift = 2 * GRID_TILE_SHIFT + tileXBits;
+    cellCount = tileRows << layout->yHighShift;
+    break;
+  }
+  default:
+    layout->kind = GRID_LAYOUT_ROW_MAJOR;
+    cellCount = (uint64_t)width * (uint64_t)height;
+    break;
+  }
+  if (cellCount > (uint64_t)UINT32_MAX) {
+    return false;
+  }
+  layout->cellCount = (size_t)cellCount;
+  if (layout->kind == GRID_LAYOUT_ROW_MAJOR) {
+    return true;
+  }
+
+  // x的位就是x取全1时编码得到的位；其余的位全部归y，掩码加减时不会漏掉进位
+  const int xSpan = kind == GRID_LAYOUT_TILED
+                        ? layout->yHighShift - GRID_TILE_SHIFT
+                        : xBits;
+  layout->xMask = encode_grid_cell_portable(
+      layout, (uint32_t)(((uint64_t)1 << xSpan) - 1), 0);
+  layout->yMask = ~layout->xMask;
+  layout->codec = select_codec();
+  return true;
+}
+
+const char *get_grid_layout_name(GridLayoutKind kind) {
+  switch (kind) {
+  case GRID_LAYOUT_MORTON:
+    return "morton";
+  case GRID_LAYOUT_TILED:
+    return "tiled";
+  default:
+    return "row-major";
+  }
+}
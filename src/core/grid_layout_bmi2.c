@@ -0,0 +1,22 @@
+#include "core/grid_layout.h"
+#include <stddef.h>
+
+// 由src/CMakeLists.txt以-mbmi2编译
+#if defined(__BMI2__)
+#include <immintrin.h>
+
+static uint32_t encode_bmi2(const GridLayout *layout, uint32_t x, uint32_t y) {
+  return _pdep_u32(x, layout->xMask) | _pdep_u32(y, layout->yMask);
+}
+
+static void decode_bmi2(const GridLayout *layout, uint32_t index, int *x,
+                        int *y) {
+  *x = (int)_pext_u32(index, layout->xMask);
+  *y = (int)_pext_u32(index, layout->yMask);
+}
+
+static const GridLayoutCodec bmi2Codec = {encode_bmi2, decode_bmi2};
+const GridLayoutCodec *const gridLayoutCodecBmi2 = &bmi2Codec;
+#else
+const GridLayoutCodec *const gridLayoutCodecBmi2 = NULL;
+#endif
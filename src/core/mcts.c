@@ -0,0 +1,460 @@
+#include "core/mcts.h"
+#include "utils/memory.h"
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+
+// 节点被访问到这个次数后才扩展子节点，避免每次迭代都沿新分支一路扩展到底
+#define MCTS_EXPAND_VISITS 2
+// 每个节点的子节点数：反向移动会被忽略，只保留三个方向
+#define MCTS_CHILD_COUNT 3
+// 食物的折扣系数：越早吃到的食物价值越高，否则蛇会满足于原地绕圈
+#define MCTS_DISCOUNT 0.9f
+// 置换表中的局面累计到这么多次模拟后，直接用平均值代替新的模拟
+#define MCTS_TRUSTED_SAMPLES 16
+
+// 每个线程独占的工作区
+struct MctsWorker {
+  MctsPlayer *player;
+  SearchState state;          // 当前迭代的局面副本
+  int path[MCTS_MAX_DEPTH];   // 本次迭代经过的节点
+  uint64_t rngState;          // 选择模拟动作的随机数状态
+  TranspositionStats stats;   // 本次搜索的置换表统计
+  int rollouts;               // 本次搜索完成的迭代次数
+  SDL_Semaphore *start;       // 调用线程发出信号后开始本次搜索
+  SDL_Thread *thread;         // 常驻线程，创建失败时为NULL
+};
+
+static inline Direction reverse_direction(Direction direction) {
+  return (Direction)(direction ^ 1); // UP/DOWN、LEFT/RIGHT两两相邻
+}
+
+// xorshift64*
+static inline uint32_t next_worker_random(MctsWorker *worker) {
+  uint64_t x = worker->rngState;
+  x ^= x >> 12;
+  x ^= x << 25;
+  x ^= x >> 27;
+  worker->rngState = x;
+  return (uint32_t)((x * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+static void reset_node(MctsNode *node, Direction action) {
+  SDL_SetAtomicInt(&node->visits, 0);
+  SDL_SetAtomicInt(&node->value, 0);
+  node->action = action;
+  SDL_SetAtomicInt(&node->children, 0);
+}
+
+MctsConfig mcts_default_config(void) {
+  MctsConfig config;
+  config.threadCount = SDL_GetNumLogicalCPUCores();
+  config.nodeCapacity = 1 << 18;
+  config.iterations = 20000;
+  config.rolloutDepth = 64;
+  config.exploration = 0.5f;
+  config.policy = MCTS_ROLLOUT_HEURISTIC;
+  config.seed = 0x9E3779B97F4A7C15ULL;
+  config.tableMegabytes = 16;
+  return config;
+}
+
+static int mcts_worker_thread(void *data);
+
+void init_mcts_player(MctsPlayer *player, const MctsConfig *config) {
+  player->config = *config;
+  if (player->config.threadCount < 1) {
+    player->config.threadCount = 1;
+  }
+  if (player->config.nodeCapacity < 1) {
+    player->config.nodeCapacity = 1;
+  }
+  // 根节点的价值之和不能溢出
+  if (player->config.iterations > INT_MAX / MCTS_VALUE_SCALE) {
+    player->config.iterations = INT_MAX / MCTS_VALUE_SCALE;
+  }
+
+  player->nodes = NEW_ARRAY(MctsNode, player->config.nodeCapacity);
+  player->workers = NEW_ARRAY(MctsWorker, player->config.threadCount);
+  if (player->config.tableMegabytes > 0) {
+    init_transposition_table(&player->table,
+                             (size_t)player->config.tableMegabytes);
+  }
+  SDL_SetAtomicInt(&player->nodeCount, 0);
+  SDL_SetAtomicInt(&player->issued, 0);
+
+  for (int i = 0; i < player->config.threadCount; i++) {
+    MctsWorker *worker = &player->workers[i];
+    worker->player = player;
+    // xorshift的状态不能为0
+    worker->rngState =
+        (player->config.seed ^ (0xD1B54A32D192ED03ULL * (uint64_t)(i + 1))) | 1;
+    worker->rollouts = 0;
+    worker->start = NULL;
+    worker->thread = NULL;
+  }
+
+  // 搜索线程常驻，每次搜索只需唤醒；创建失败时剩余的迭代由其他线程完成
+  player->quit = false;
+  player->done = SDL_CreateSemaphore(0);
+  for (int i = 1; i < player->config.threadCount && player->done; i++) {
+    MctsWorker *worker = &player->workers[i];
+    worker->start = SDL_CreateSemaphore(0);
+    worker->thread =
+        worker->start != NULL
+            ? SDL_CreateThread(mcts_worker_thread, "mcts", worker)
+            : NULL;
+    if (worker->thread == NULL) {
+      SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "创建搜索线程失败: %s",
+                  SDL_GetError());
+      SDL_DestroySemaphore(worker->start);
+      worker->start = NULL;
+    }
+  }
+}
+
+void cleanup_mcts_player(MctsPlayer *player) {
+  player->quit = true;
+  for (int i = 1; i < player->config.threadCount; i++) {
+    MctsWorker *worker = &player->workers[i];
+    if (worker->thread) {
+      SDL_SignalSemaphore(worker->start);
+      SDL_WaitThread(worker->thread, NULL);
+      SDL_DestroySemaphore(worker->start);
+      worker->thread = NULL;
+    }
+  }
+  if (player->done) {
+    SDL_DestroySemaphore(player->done);
+    player->done = NULL;
+  }
+  FREE(player->nodes);
+  if (player->config.tableMegabytes > 0) {
+    cleanup_transposition_table(&player->table);
+  }
+  FREE(player->workers);
+}
+
+/**
+ * 扩展节点并返回第一个子节点的下标；其他线程正在扩展或节点池已满时返回-1，
+ * 调用方直接从该节点开始模拟
+ */
+static int expand_node(MctsPlayer *player, MctsNode *node,
+                       const SearchState *state) {
+  if (SDL_GetAtomicInt(&player->nodeCount) + MCTS_CHILD_COUNT >
+      player->config.nodeCapacity) {
+    return -1;
+  }
+  if (!SDL_CompareAndSwapAtomicInt(&node->children, 0, -1)) {
+    return SDL_GetAtomicInt(&node->children);
+  }
+
+  int first = SDL_AddAtomicInt(&player->nodeCount, MCTS_CHILD_COUNT);
+  if (first + MCTS_CHILD_COUNT > player->config.nodeCapacity) {
+    SDL_SetAtomicInt(&node->children, 0);
+    return -1;
+  }
+
+  int index = first;
+  for (int k = 0; k < 4; k++) {
+    if ((Direction)k != reverse_direction(state->direction)) {
+      reset_node(&player->nodes[index++], (Direction)k);
+    }
+  }
+  // 子节点初始化完成后才发布
+  SDL_SetAtomicInt(&node->children, first);
+  return first;
+}
+
+// UCT选择；未访问过的子节点优先
+static int select_child(const MctsPlayer *player, MctsNode *parent, int first) {
+  const float logVisits = logf((float)SDL_GetAtomicInt(&parent->visits));
+  int best = first;
+  float bestScore = -1.0f;
+  for (int i = first; i < first + MCTS_CHILD_COUNT; i++) {
+    MctsNode *child = &player->nodes[i];
+    int visits = SDL_GetAtomicInt(&child->visits);
+    if (visits == 0) {
+      return i;
+    }
+    float mean = (float)SDL_GetAtomicInt(&child->value) /
+                 ((float)visits * MCTS_VALUE_SCALE);
+    float score =
+        mean + player->config.exploration * sqrtf(logVisits / (float)visits);
+    if (score > bestScore) {
+      best = i;
+      bestScore = score;
+    }
+  }
+  return best;
+}
+
+// 避开立即致死的方向，多数时候朝最近的食物走，其余时候在安全方向中随机
+static Direction heuristic_move(MctsWorker *worker, const SearchState *state) {
+  Direction safe[MCTS_CHILD_COUNT];
+  int safeCount = 0;
+  for (int k = 0; k < 4; k++) {
+    if ((Direction)k != reverse_direction(state->direction) &&
+        !is_search_move_fatal(state, (Direction)k)) {
+      safe[safeCount++] = (Direction)k;
+    }
+  }
+  if (safeCount == 0) {
+    return state->direction;
+  }
+
+  uint32_t random = next_worker_random(worker);
+  if ((random & 3) == 0 || state->foodCount == 0) {
+    return safe[(random >> 2) % (uint32_t)safeCount];
+  }
+
+  int headX, headY;
+  get_search_head(state, &headX, &headY);
+  int targetX = headX, targetY = headY;
+  int nearest = -1;
+  for (int i = 0; i < state->foodCount; i++) {
+    int x = state->foods[i] % state->gridWidth;
+    int y = state->foods[i] / state->gridWidth;
+    int distance = abs(x - headX) + abs(y - headY);
+    if (nearest < 0 || distance < nearest) {
+      nearest = distance;
+      targetX = x;
+      targetY = y;
+    }
+  }
+
+  static const int deltaX[4] = {0, 0, -1, 1};
+  static const int deltaY[4] = {-1, 1, 0, 0};
+  Direction best = safe[0];
+  int bestDistance = -1;
+  for (int i = 0; i < safeCount; i++) {
+    int distance = abs(headX + deltaX[safe[i]] - targetX) +
+                   abs(headY + deltaY[safe[i]] - targetY);
+    if (bestDistance < 0 || distance < bestDistance) {
+      best = safe[i];
+      bestDistance = distance;
+    }
+  }
+  return best;
+}
+
+// 叶节点之后的模拟结果
+typedef struct {
+  float survival; // 模拟结束时存活的比例
+  float food;     // 从叶节点起吃到食物的折扣之和（上限为1）
+} LeafValue;
+
+// 从当前局面模拟到蛇死亡或达到最大步数
+static LeafValue rollout(MctsWorker *worker, SearchState *state) {
+  const MctsConfig *config = &worker->player->config;
+  float food = 0.0f;
+  float weight = 1.0f;
+  for (int step = 0; step < config->rolloutDepth && state->alive; step++) {
+    Direction direction;
+    if (config->policy == MCTS_ROLLOUT_HEURISTIC) {
+      direction = heuristic_move(worker, state);
+    } else {
+      // 三个非反向方向之一
+      int k = (int)(next_worker_random(worker) % MCTS_CHILD_COUNT);
+      direction = (Direction)k;
+      if (direction == reverse_direction(state->direction)) {
+        direction = (Direction)MCTS_CHILD_COUNT;
+      }
+    }
+    const int score = state->score;
+    step_search_state(state, direction);
+    food += weight * (float)(state->score - score);
+    weight *= MCTS_DISCOUNT;
+  }
+
+  LeafValue leaf = {state->alive ? 1.0f : 0.0f, food < 1.0f ? food : 1.0f};
+  return leaf;
+}
+
+// 两个[0, 1]的分量各量化为16位，打包进置换表条目的value
+static inline int32_t pack_leaf_value(LeafValue leaf) {
+  uint32_t survival = (uint32_t)(leaf.survival * 65535.0f + 0.5f);
+  uint32_t food = (uint32_t)(leaf.food * 65535.0f + 0.5f);
+  return (int32_t)(survival << 16 | food);
+}
+
+static inline LeafValue unpack_leaf_value(int32_t value) {
+  LeafValue leaf = {(float)((uint32_t)value >> 16) / 65535.0f,
+                    (float)((uint32_t)value & 0xFFFF) / 65535.0f};
+  return leaf;
+}
+
+/**
+ * 叶节点的估值。使用置换表时，同一局面（不论经由哪条路径到达）的模拟结果
+ * 累积为平均值，样本达到MCTS_TRUSTED_SAMPLES后直接使用平均值，不再模拟
+ */
+static LeafValue evaluate_leaf(MctsWorker *worker, SearchState *state,
+                               uint64_t key) {
+  MctsPlayer *player = worker->player;
+  if (player->config.tableMegabytes <= 0 || !state->alive) {
+    return rollout(worker, state);
+  }
+
+  TranspositionData data;
+  int samples = 0;
+  LeafValue mean = {0.0f, 0.0f};
+  if (probe_transposition(&player->table, key, &data, &worker->stats)) {
+    samples = data.depth;
+    mean = unpack_leaf_value(data.value);
+    if (samples >= MCTS_TRUSTED_SAMPLES) {
+      return mean;
+    }
+  }
+
+  // 并发更新同一条目时可能丢失样本，不影响正确性
+  const LeafValue leaf = rollout(worker, state);
+  mean.survival += (leaf.survival - mean.survival) / (float)(samples + 1);
+  mean.food += (leaf.food - mean.food) / (float)(samples + 1);
+  data.value = pack_leaf_value(mean);
+  data.depth = (uint16_t)(samples + 1);
+  data.move = 0; // 蒙特卡洛搜索不使用
+  store_transposition(&player->table, key, &data, &worker->stats);
+  return leaf;
+}
+
+static void run_iteration(MctsWorker *worker) {
+  MctsPlayer *player = worker->player;
+  SearchState *state = &worker->state;
+  copy_search_state(state, &player->root);
+
+  int index = 0;
+  int depth = 0;
+  worker->path[depth++] = index;
+  SDL_AddAtomicInt(&player->nodes[index].visits, 1);
+
+  // 选择：沿途先增加访问次数（虚拟损失），价值在回传时再加上
+  float food = 0.0f;
+  float weight = 1.0f;
+  while (state->alive && depth < MCTS_MAX_DEPTH) {
+    MctsNode *node = &player->nodes[index];
+    int first = SDL_GetAtomicInt(&node->children);
+    if (first == 0) {
+      if (SDL_GetAtomicInt(&node->visits) < MCTS_EXPAND_VISITS) {
+        break;
+      }
+      first = expand_node(player, node, state);
+    }
+    if (first <= 0) {
+      break;
+    }
+
+    index = select_child(player, node, first);
+    SDL_AddAtomicInt(&player->nodes[index].visits, 1);
+    worker->path[depth++] = index;
+    const int score = state->score;
+    step_search_state(state, player->nodes[index].action);
+    food += weight * (float)(state->score - score);
+    weight *= MCTS_DISCOUNT;
+
+    // 每到一个节点就预取它在置换表中的桶，到达叶节点时桶通常已在缓存中
+    if (player->config.tableMegabytes > 0) {
+      prefetch_transposition(&player->table, search_state_hash(state));
+    }
+  }
+
+  // 定点价值：存活的结果总是优于死亡；食物按吃到的先后折扣后求和（上限为1），
+  // 主要取决于多快吃到下一个食物
+  const uint64_t key =
+      player->config.tableMegabytes > 0 ? search_state_hash(state) : 0;
+  const LeafValue leaf = evaluate_leaf(worker, state, key);
+  food += weight * leaf.food;
+  const float half = MCTS_VALUE_SCALE / 2;
+  const int value =
+      (int)(half * leaf.survival + half * (food < 1.0f ? food : 1.0f));
+  for (int i = 0; i < depth; i++) {
+    SDL_AddAtomicInt(&player->nodes[worker->path[i]].value, value);
+  }
+}
+
+// 领取迭代直到本次搜索的迭代次数分配完
+static void run_worker(MctsWorker *worker) {
+  MctsPlayer *player = worker->player;
+  while (SDL_AddAtomicInt(&player->issued, 1) < player->config.iterations) {
+    run_iteration(worker);
+    worker->rollouts++;
+  }
+}
+
+static int mcts_worker_thread(void *data) {
+  MctsWorker *worker = (MctsWorker *)data;
+  MctsPlayer *player = worker->player;
+  while (true) {
+    SDL_WaitSemaphore(worker->start);
+    if (player->quit) {
+      return 0;
+    }
+    run_worker(worker);
+    SDL_SignalSemaphore(player->done);
+  }
+}
+
+bool mcts_search(MctsPlayer *player, const Game *game, MctsResult *result) {
+  // 待生效的nextDirection会被本次搜索的结果覆盖，反向限制以currentDirection为准
+  if (!load_search_state(&player->root, game)) {
+    return false;
+  }
+
+  reset_node(&player->nodes[0], player->root.direction);
+  if (player->config.tableMegabytes > 0) {
+    new_transposition_generation(&player->table);
+  }
+  SDL_SetAtomicInt(&player->nodeCount, 1);
+  SDL_SetAtomicInt(&player->issued, 0);
+
+  const Uint64 start = SDL_GetTicksNS();
+  for (int i = 0; i < player->config.threadCount; i++) {
+    player->workers[i].rollouts = 0;
+    memset(&player->workers[i].stats, 0, sizeof(TranspositionStats));
+  }
+  // 唤醒常驻线程，调用线程也参与搜索；信号量的发出与等待保证了根局面和
+  // 各线程统计的可见性
+  for (int i = 1; i < player->config.threadCount; i++) {
+    if (player->workers[i].thread) {
+      SDL_SignalSemaphore(player->workers[i].start);
+    }
+  }
+  run_worker(&player->workers[0]);
+  for (int i = 1; i < player->config.threadCount; i++) {
+    if (player->workers[i].thread) {
+      SDL_WaitSemaphore(player->done);
+    }
+  }
+
+  int iterations = 0;
+  memset(&result->table, 0, sizeof(TranspositionStats));
+  for (int i = 0; i < player->config.threadCount; i++) {
+    MctsWorker *worker = &player->workers[i];
+    iterations += worker->rollouts;
+    merge_transposition_stats(&result->table, &worker->stats);
+  }
+  const Uint64 elapsed = SDL_GetTicksNS() - start;
+
+  // 访问次数最多的子节点；根节点没有扩展时沿当前方向继续
+  result->bestMove = player->root.direction;
+  const int first = SDL_GetAtomicInt(&player->nodes[0].children);
+  int bestVisits = -1;
+  for (int i = first; first > 0 && i < first + MCTS_CHILD_COUNT; i++) {
+    int visits = SDL_GetAtomicInt(&player->nodes[i].visits);
+    if (visits > bestVisits) {
+      result->bestMove = player->nodes[i].action;
+      bestVisits = visits;
+    }
+  }
+
+  int nodes = SDL_GetAtomicInt(&player->nodeCount);
+  if (nodes > player->config.nodeCapacity) {
+    nodes = player->config.nodeCapacity;
+  }
+  result->iterations = iterations;
+  result->nodes = nodes;
+  result->seconds = (double)elapsed / 1e9;
+  result->nodesPerSecond = elapsed > 0 ? nodes / result->seconds : 0.0;
+  result->rolloutsPerSecond =
+      elapsed > 0 ? iterations / result->seconds : 0.0;
+  return true;
+}
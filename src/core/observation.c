@@ -0,0 +1,146 @@
+#include "core/observation.h"
+#include <string.h>
+
+static inline void set_bit(uint64_t *plane, int index) {
+  plane[index >> 6] |= 1ULL << (index & 63);
+}
+
+static inline bool in_grid(const GameConfig *config, int x, int y) {
+  return x >= 0 && x < config->gridWidth && y >= 0 && y < config->gridHeight;
+}
+
+// 以下写入函数都假设输出已清零，只设置非零位置
+
+static void write_wall_bits(const GameConfig *config, uint64_t *plane) {
+  const int width = config->gridWidth;
+  const int height = config->gridHeight;
+  for (int x = 0; x < width; x++) {
+    set_bit(plane, x);
+    set_bit(plane, (height - 1) * width + x);
+  }
+  for (int y = 1; y < height - 1; y++) {
+    set_bit(plane, y * width);
+    set_bit(plane, y * width + width - 1);
+  }
+}
+
+static void write_planes(const Game *game, uint64_t *planes, size_t words) {
+  const GameConfig *config = &game->state.config;
+  const int width = config->gridWidth;
+  uint64_t *body = planes + OBS_PLANE_BODY * words;
+  uint64_t *head = planes + OBS_PLANE_HEAD * words;
+  uint64_t *food = planes + OBS_PLANE_FOOD * words;
+
+  const KNode *node;
+  bool first = true;
+  knode_for_each(node, &game->snake.head) {
+    const SnakeSegment *segment = container_of(node, SnakeSegment, node);
+    if (in_grid(config, segment->x, segment->y)) {
+      int index = segment->y * width + segment->x;
+      set_bit(body, index);
+      if (first) {
+        set_bit(head, index);
+      }
+    }
+    first = false;
+  }
+
+  knode_for_each(node, &game->foodManager.head) {
+    const Food *item = container_of(node, Food, node);
+    if (in_grid(config, item->x, item->y)) {
+      set_bit(food, item->y * width + item->x);
+    }
+  }
+
+  write_wall_bits(config, planes + OBS_PLANE_WALL * words);
+}
+
+static void write_tensor(const Game *game, uint8_t *tensor) {
+  const GameConfig *config = &game->state.config;
+  const int width = config->gridWidth;
+  const int height = config->gridHeight;
+  const size_t cells = (size_t)width * height;
+  uint8_t *body = tensor + OBS_PLANE_BODY * cells;
+  uint8_t *head = tensor + OBS_PLANE_HEAD * cells;
+  uint8_t *food = tensor + OBS_PLANE_FOOD * cells;
+  uint8_t *wall = tensor + OBS_PLANE_WALL * cells;
+  uint8_t *age = tensor + OBS_CHANNEL_AGE * cells;
+
+  // 年龄按蛇身顺序线性量化到[1, 255]，蛇头最新
+  const int length = game->snake.length > 0 ? game->snake.length : 1;
+  const KNode *node;
+  int order = 0;
+  knode_for_each(node, &game->snake.head) {
+    const SnakeSegment *segment = container_of(node, SnakeSegment, node);
+    if (in_grid(config, segment->x, segment->y)) {
+      size_t index = (size_t)segment->y * width + segment->x;
+      body[index] = 1;
+      if (order == 0) {
+        head[index] = 1;
+      }
+      int value = order < length ? 255 - order * 254 / length : 1;
+      age[index] = (uint8_t)value;
+    }
+    order++;
+  }
+
+  knode_for_each(node, &game->foodManager.head) {
+    const Food *item = container_of(node, Food, node);
+    if (in_grid(config, item->x, item->y)) {
+      food[(size_t)item->y * width + item->x] = 1;
+    }
+  }
+
+  // 上下两行整行写入，左右两列逐行写入
+  memset(wall, 1, (size_t)width);
+  memset(wall + (size_t)(height - 1) * width, 1, (size_t)width);
+  for (int y = 1; y < height - 1; y++) {
+    wall[(size_t)y * width] = 1;
+    wall[(size_t)y * width + width - 1] = 1;
+  }
+}
+
+size_t observation_plane_words(const GameConfig *config) {
+  size_t cells = (size_t)config->gridWidth * config->gridHeight;
+  return (cells + 63) / 64;
+}
+
+size_t observation_tensor_size(const GameConfig *config) {
+  return (size_t)OBS_CHANNEL_COUNT * config->gridWidth * config->gridHeight;
+}
+
+void encode_observation_planes(const Game *game, uint64_t *planes) {
+  encode_observation_planes_batch(&game, 1, planes);
+}
+
+void encode_observation_tensor(const Game *game, uint8_t *tensor) {
+  encode_observation_tensor_batch(&game, 1, tensor);
+}
+
+void encode_observation_planes_batch(const Game *const *games, int count,
+                                     uint64_t *planes) {
+  if (count <= 0) {
+    return;
+  }
+
+  // 整批输出一次清零，之后每个游戏只写入非零位
+  const size_t words = observation_plane_words(&games[0]->state.config);
+  const size_t stride = OBS_PLANE_COUNT * words;
+  memset(planes, 0, sizeof(uint64_t) * stride * count);
+  for (int i = 0; i < count; i++) {
+    write_planes(games[i], planes + stride * i, words);
+  }
+}
+
+void encode_observation_tensor_batch(const Game *const *games, int count,
+                                     uint8_t *tensor) {
+  if (count <= 0) {
+    return;
+  }
+
+  const size_t stride = observation_tensor_size(&games[0]->state.config);
+  memset(tensor, 0, stride * count);
+  for (int i = 0; i < count; i++) {
+    write_tensor(games[i], tensor + stride * i);
+  }
+}
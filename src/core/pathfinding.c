@@ -0,0 +1,272 @@
+#include "core/pathfinding.h"
+#include "utils/memory.h"
+
+// A*中每个格子最多被压入堆的次数（每个邻居最多改进它一次）
+#define OPEN_PER_CELL 4
+
+static inline int cell_index(const PathFinder *finder, int x, int y) {
+  return (int)get_grid_cell_index(&finder->layout, x + 1, y + 1);
+}
+
+static inline bool in_grid(const PathFinder *finder, int x, int y) {
+  return x >= 0 && x < finder->gridWidth && y >= 0 && y < finder->gridHeight;
+}
+
+static inline int neighbor_cell(const PathFinder *finder, int cell,
+                                Direction direction) {
+  return (int)step_grid_cell(&finder->layout, (uint32_t)cell, direction);
+}
+
+// 到目标的曼哈顿距离，目标为带墙网格中的坐标
+static inline int heuristic(const PathFinder *finder, int cell, int goalX,
+                            int goalY) {
+  int x, y;
+  get_grid_cell_coords(&finder->layout, (uint32_t)cell, &x, &y);
+  return abs(x - goalX) + abs(y - goalY);
+}
+
+// 第step步能否进入cell
+static inline bool passable(const PathFinder *finder, int cell, int step) {
+  return !finder->walls[cell] &&
+         (finder->occupiedMarks[cell] != finder->generation ||
+          step >= finder->freeAt[cell]);
+}
+
+// 开始新一次搜索：递增代数，标记蛇身并以蛇头为起点
+static bool begin_search(PathFinder *finder, const Snake *snake) {
+  finder->target = -1;
+  if (snake->length <= 0 || knode_empty(&snake->head)) {
+    return false;
+  }
+
+  if (++finder->generation == 0) {
+    // 代数回绕时清空标记，避免很久以前的标记被当作有效
+    size_t bytes = sizeof(uint32_t) * finder->cellCount;
+    memset(finder->visitMarks, 0, bytes);
+    memset(finder->occupiedMarks, 0, bytes);
+    memset(finder->foodMarks, 0, bytes);
+    finder->generation = 1;
+  }
+  const uint32_t generation = finder->generation;
+
+  int order = 0;
+  const KNode *node;
+  knode_for_each(node, &snake->head) {
+    const SnakeSegment *segment = container_of(node, SnakeSegment, node);
+    if (in_grid(finder, segment->x, segment->y)) {
+      int cell = cell_index(finder, segment->x, segment->y);
+      finder->occupiedMarks[cell] = generation;
+      finder->freeAt[cell] = snake->length - order + 1;
+      if (order == 0) {
+        finder->start = cell;
+      }
+    }
+    order++;
+  }
+
+  finder->visitMarks[finder->start] = generation;
+  finder->distance[finder->start] = 0;
+  finder->parent[finder->start] = -1;
+  return true;
+}
+
+// ---------------- 二叉堆（高32位为f值，低32位为格子） ----------------
+
+static void heap_push(uint64_t *heap, int *size, uint64_t value) {
+  int i = (*size)++;
+  while (i > 0) {
+    int parent = (i - 1) / 2;
+    if (heap[parent] <= value) {
+      break;
+    }
+    heap[i] = heap[parent];
+    i = parent;
+  }
+  heap[i] = value;
+}
+
+static uint64_t heap_pop(uint64_t *heap, int *size) {
+  uint64_t top = heap[0];
+  uint64_t last = heap[--(*size)];
+  int i = 0;
+  for (;;) {
+    int child = 2 * i + 1;
+    if (child >= *size) {
+      break;
+    }
+    if (child + 1 < *size && heap[child + 1] < heap[child]) {
+      child++;
+    }
+    if (last <= heap[child]) {
+      break;
+    }
+    heap[i] = heap[child];
+    i = child;
+  }
+  heap[i] = last;
+  return top;
+}
+
+// ---------------- 对外接口 ----------------
+
+void init_path_finder(PathFinder *finder, int gridWidth, int gridHeight,
+                      GridLayoutKind layout) {
+  finder->gridWidth = gridWidth;
+  finder->gridHeight = gridHeight;
+  if (!init_grid_layout(&finder->layout, layout, gridWidth + 2,
+                        gridHeight + 2)) {
+    init_grid_layout(&finder->layout, GRID_LAYOUT_ROW_MAJOR, gridWidth + 2,
+                     gridHeight + 2);
+  }
+  finder->cellCount = (int)finder->layout.cellCount;
+  finder->generation = 0;
+
+  // 非行优先的排列可能有填充的格子，它们在墙外，永远不会被访问
+  const int count = finder->cellCount;
+  finder->walls = NEW_ARRAY_ZEROED(uint8_t, count);
+  for (int y = 0; y < gridHeight + 2; y++) {
+    for (int x = 0; x < gridWidth + 2; x++) {
+      if (x == 0 || y == 0 || x == gridWidth + 1 || y == gridHeight + 1) {
+        finder->walls[get_grid_cell_index(&finder->layout, x, y)] = 1;
+      }
+    }
+  }
+
+  finder->visitMarks = NEW_ARRAY_ZEROED(uint32_t, count);
+  finder->occupiedMarks = NEW_ARRAY_ZEROED(uint32_t, count);
+  finder->foodMarks = NEW_ARRAY_ZEROED(uint32_t, count);
+  finder->freeAt = NEW_ARRAY(int, count);
+  finder->distance = NEW_ARRAY(int, count);
+  finder->parent = NEW_ARRAY(int, count);
+  finder->open = NEW_ARRAY(uint64_t, count * OPEN_PER_CELL);
+  finder->start = -1;
+  finder->target = -1;
+}
+
+void cleanup_path_finder(PathFinder *finder) {
+  FREE(finder->walls);
+  FREE(finder->visitMarks);
+  FREE(finder->occupiedMarks);
+  FREE(finder->foodMarks);
+  FREE(finder->freeAt);
+  FREE(finder->distance);
+  FREE(finder->parent);
+  FREE(finder->open);
+}
+
+int find_nearest_food_path(PathFinder *finder, const Snake *snake,
+                           const FoodManager *foodManager) {
+  if (!begin_search(finder, snake)) {
+    return -1;
+  }
+  const uint32_t generation = finder->generation;
+
+  const KNode *node;
+  knode_for_each(node, &foodManager->head) {
+    const Food *food = container_of(node, Food, node);
+    if (in_grid(finder, food->x, food->y)) {
+      finder->foodMarks[cell_index(finder, food->x, food->y)] = generation;
+    }
+  }
+
+  // 每个格子最多入队一次，队列不会超过cellCount
+  uint64_t *queue = finder->open;
+  int head = 0, tail = 0;
+  queue[tail++] = (uint64_t)finder->start;
+  while (head < tail) {
+    const int cell = (int)queue[head++];
+    const int step = finder->distance[cell] + 1;
+    for (int k = 0; k < 4; k++) {
+      const int next = neighbor_cell(finder, cell, (Direction)k);
+      if (finder->visitMarks[next] == generation ||
+          !passable(finder, next, step)) {
+        continue;
+      }
+      finder->visitMarks[next] = generation;
+      finder->distance[next] = step;
+      finder->parent[next] = cell;
+      // 按层扩展，第一次发现的食物就是最近的
+      if (finder->foodMarks[next] == generation) {
+        finder->target = next;
+        return step;
+      }
+      queue[tail++] = (uint64_t)next;
+    }
+  }
+  return -1;
+}
+
+int find_path_to(PathFinder *finder, const Snake *snake, int targetX,
+                 int targetY) {
+  if (!in_grid(finder, targetX, targetY) || !begin_search(finder, snake)) {
+    return -1;
+  }
+  const uint32_t generation = finder->generation;
+  const int goal = cell_index(finder, targetX, targetY);
+  const int goalX = targetX + 1;
+  const int goalY = targetY + 1;
+  if (goal == finder->start) {
+    finder->target = goal;
+    return 0;
+  }
+
+  uint64_t *heap = finder->open;
+  const int capacity = finder->cellCount * OPEN_PER_CELL;
+  int size = 0;
+  const int startCost = heuristic(finder, finder->start, goalX, goalY);
+  heap_push(heap, &size, ((uint64_t)startCost << 32) | (uint32_t)finder->start);
+
+  while (size > 0) {
+    const uint64_t top = heap_pop(heap, &size);
+    const int cell = (int)(uint32_t)top;
+    const int cost = (int)(top >> 32) - heuristic(finder, cell, goalX, goalY);
+    if (cost != finder->distance[cell]) {
+      continue; // 已有更短的路径，跳过过期的堆项
+    }
+    if (cell == goal) {
+      finder->target = goal;
+      return cost;
+    }
+
+    const int step = cost + 1;
+    for (int k = 0; k < 4; k++) {
+      const int next = neighbor_cell(finder, cell, (Direction)k);
+      if (!passable(finder, next, step) ||
+          (finder->visitMarks[next] == generation &&
+           finder->distance[next] <= step)) {
+        continue;
+      }
+      if (size == capacity) {
+        return -1;
+      }
+      finder->visitMarks[next] = generation;
+      finder->distance[next] = step;
+      finder->parent[next] = cell;
+      const int estimate = step + heuristic(finder, next, goalX, goalY);
+      heap_push(heap, &size, ((uint64_t)estimate << 32) | (uint32_t)next);
+    }
+  }
+  return -1;
+}
+
+int get_path_moves(const PathFinder *finder, Direction *moves, int capacity) {
+  if (finder->target < 0) {
+    return -1;
+  }
+
+  // 从终点沿前驱回溯，倒序写入
+  const int length = finder->distance[finder->target];
+  int cell = finder->target;
+  for (int i = length - 1; i >= 0; i--) {
+    const int previous = finder->parent[cell];
+    if (i < capacity) {
+      Direction direction = DIRECTION_UP;
+      while (neighbor_cell(finder, previous, direction) != cell) {
+        direction++;
+      }
+      moves[i] = direction;
+    }
+    cell = previous;
+  }
+  return length;
+}
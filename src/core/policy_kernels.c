@@ -0,0 +1,155 @@
+#include "core/policy_kernels.h"
+#include <stddef.h>
+
+// 一次处理4行和两个输入向量，8个累加器最后按向量归约，每读一次权重用于两个
+// 向量；count为奇数时最后一个向量单独处理
+
+static void matmul_f32_scalar(const float *w, int stride, int rows,
+                              const float *x, int count, float *y, int ldy) {
+  for (int r = 0; r < rows; r++) {
+    const float *row = w + (size_t)r * stride;
+    for (int b = 0; b < count; b++) {
+      const float *xb = x + (size_t)b * stride;
+      float sum = 0.0f;
+      for (int i = 0; i < stride; i++) {
+        sum += row[i] * xb[i];
+      }
+      y[(size_t)b * ldy + r] = sum;
+    }
+  }
+}
+
+static void matmul_i8_scalar(const int8_t *w, int stride, int rows,
+                             const int8_t *x, int count, float *y, int ldy) {
+  for (int r = 0; r < rows; r++) {
+    const int8_t *row = w + (size_t)r * stride;
+    for (int b = 0; b < count; b++) {
+      const int8_t *xb = x + (size_t)b * stride;
+      int32_t sum = 0;
+      for (int i = 0; i < stride; i++) {
+        sum += (int32_t)row[i] * xb[i];
+      }
+      y[(size_t)b * ldy + r] = (float)sum;
+    }
+  }
+}
+
+static const PolicyKernels scalarKernels = {matmul_f32_scalar,
+                                            matmul_i8_scalar};
+const PolicyKernels *const policyKernelsScalar = &scalarKernels;
+
+#if defined(__SSE2__)
+// SSE2是x86-64的基线指令集，无需额外的编译选项
+
+// int8符号扩展为int16
+static inline __m128i widen_low_i8(__m128i v) {
+  return _mm_srai_epi16(_mm_unpacklo_epi8(v, v), 8);
+}
+
+static inline __m128i widen_high_i8(__m128i v) {
+  return _mm_srai_epi16(_mm_unpackhi_epi8(v, v), 8);
+}
+
+// 4行与vectors（1或2）个向量的点积，内联后vectors为常量，循环完全展开
+POLICY_KERNEL_INLINE void dot4_f32_sse2(const float *row, int stride,
+                                        const float *x, int vectors, float *y,
+                                        int ldy) {
+  __m128 sum[2][4];
+  for (int v = 0; v < vectors; v++) {
+    for (int k = 0; k < 4; k++) {
+      sum[v][k] = _mm_setzero_ps();
+    }
+  }
+  for (int i = 0; i < stride; i += 4) {
+    __m128 vx[2];
+    for (int v = 0; v < vectors; v++) {
+      vx[v] = _mm_loadu_ps(x + (size_t)v * stride + i);
+    }
+    for (int k = 0; k < 4; k++) {
+      __m128 vw = _mm_loadu_ps(row + k * stride + i);
+      for (int v = 0; v < vectors; v++) {
+        sum[v][k] = _mm_add_ps(sum[v][k], _mm_mul_ps(vw, vx[v]));
+      }
+    }
+  }
+  for (int v = 0; v < vectors; v++) {
+    _mm_storeu_ps(y + (size_t)v * ldy,
+                  policy_reduce4_ps(sum[v][0], sum[v][1], sum[v][2],
+                                    sum[v][3]));
+  }
+}
+
+void policy_matmul_f32_sse2(const float *w, int stride, int rows,
+                            const float *x, int count, float *y, int ldy) {
+  for (int r = 0; r < rows; r += 4) {
+    const float *row = w + (size_t)r * stride;
+    int b = 0;
+    for (; b + 2 <= count; b += 2) {
+      dot4_f32_sse2(row, stride, x + (size_t)b * stride, 2,
+                    y + (size_t)b * ldy + r, ldy);
+    }
+    if (b < count) {
+      dot4_f32_sse2(row, stride, x + (size_t)b * stride, 1,
+                    y + (size_t)b * ldy + r, ldy);
+    }
+  }
+}
+
+// 输入向量每16个元素只扩展一次，与4行权重共用
+POLICY_KERNEL_INLINE void dot4_i8_sse2(const int8_t *row, int stride,
+                                       const int8_t *x, int vectors, float *y,
+                                       int ldy) {
+  __m128i sum[2][4];
+  for (int v = 0; v < vectors; v++) {
+    for (int k = 0; k < 4; k++) {
+      sum[v][k] = _mm_setzero_si128();
+    }
+  }
+  for (int i = 0; i < stride; i += 16) {
+    __m128i xLow[2], xHigh[2];
+    for (int v = 0; v < vectors; v++) {
+      __m128i vx =
+          _mm_loadu_si128((const __m128i *)(x + (size_t)v * stride + i));
+      xLow[v] = widen_low_i8(vx);
+      xHigh[v] = widen_high_i8(vx);
+    }
+    for (int k = 0; k < 4; k++) {
+      __m128i vw = _mm_loadu_si128((const __m128i *)(row + k * stride + i));
+      __m128i wLow = widen_low_i8(vw);
+      __m128i wHigh = widen_high_i8(vw);
+      for (int v = 0; v < vectors; v++) {
+        sum[v][k] = _mm_add_epi32(
+            sum[v][k], _mm_add_epi32(_mm_madd_epi16(wLow, xLow[v]),
+                                     _mm_madd_epi16(wHigh, xHigh[v])));
+      }
+    }
+  }
+  for (int v = 0; v < vectors; v++) {
+    __m128i total =
+        policy_reduce4_epi32(sum[v][0], sum[v][1], sum[v][2], sum[v][3]);
+    _mm_storeu_ps(y + (size_t)v * ldy, _mm_cvtepi32_ps(total));
+  }
+}
+
+static void matmul_i8_sse2(const int8_t *w, int stride, int rows,
+                           const int8_t *x, int count, float *y, int ldy) {
+  for (int r = 0; r < rows; r += 4) {
+    const int8_t *row = w + (size_t)r * stride;
+    int b = 0;
+    for (; b + 2 <= count; b += 2) {
+      dot4_i8_sse2(row, stride, x + (size_t)b * stride, 2,
+                   y + (size_t)b * ldy + r, ldy);
+    }
+    if (b < count) {
+      dot4_i8_sse2(row, stride, x + (size_t)b * stride, 1,
+                   y + (size_t)b * ldy + r, ldy);
+    }
+  }
+}
+
+static const PolicyKernels sse2Kernels = {policy_matmul_f32_sse2,
+                                          matmul_i8_sse2};
+const PolicyKernels *const policyKernelsSse2 = &sse2Kernels;
+#else
+const PolicyKernels *const policyKernelsSse2 = NULL;
+#endif
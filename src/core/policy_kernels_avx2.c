@@ -0,0 +1,112 @@
+#include "core/policy_kernels.h"
+#include <stddef.h>
+
+// 由src/CMakeLists.txt以-mavx2编译
+#if defined(__AVX2__)
+#include <immintrin.h>
+
+// 4行与vectors（1或2）个向量的点积，内联后vectors为常量
+POLICY_KERNEL_INLINE void dot4_f32_avx2(const float *row, int stride,
+                                        const float *x, int vectors, float *y,
+                                        int ldy) {
+  __m256 sum[2][4];
+  for (int v = 0; v < vectors; v++) {
+    for (int k = 0; k < 4; k++) {
+      sum[v][k] = _mm256_setzero_ps();
+    }
+  }
+  for (int i = 0; i < stride; i += 8) {
+    __m256 vx[2];
+    for (int v = 0; v < vectors; v++) {
+      vx[v] = _mm256_loadu_ps(x + (size_t)v * stride + i);
+    }
+    for (int k = 0; k < 4; k++) {
+      __m256 vw = _mm256_loadu_ps(row + k * stride + i);
+      for (int v = 0; v < vectors; v++) {
+        sum[v][k] = _mm256_add_ps(sum[v][k], _mm256_mul_ps(vw, vx[v]));
+      }
+    }
+  }
+  for (int v = 0; v < vectors; v++) {
+    _mm_storeu_ps(y + (size_t)v * ldy,
+                  policy_reduce4_ps_avx2(sum[v][0], sum[v][1], sum[v][2],
+                                         sum[v][3]));
+  }
+}
+
+static void matmul_f32_avx2(const float *w, int stride, int rows,
+                            const float *x, int count, float *y, int ldy) {
+  for (int r = 0; r < rows; r += 4) {
+    const float *row = w + (size_t)r * stride;
+    int b = 0;
+    for (; b + 2 <= count; b += 2) {
+      dot4_f32_avx2(row, stride, x + (size_t)b * stride, 2,
+                    y + (size_t)b * ldy + r, ldy);
+    }
+    if (b < count) {
+      dot4_f32_avx2(row, stride, x + (size_t)b * stride, 1,
+                    y + (size_t)b * ldy + r, ldy);
+    }
+  }
+}
+
+// 16个int8符号扩展为16个int16
+static inline __m256i load_i8x16(const int8_t *p) {
+  return _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)p));
+}
+
+POLICY_KERNEL_INLINE void dot4_i8_avx2(const int8_t *row, int stride,
+                                       const int8_t *x, int vectors, float *y,
+                                       int ldy) {
+  __m256i sum[2][4];
+  for (int v = 0; v < vectors; v++) {
+    for (int k = 0; k < 4; k++) {
+      sum[v][k] = _mm256_setzero_si256();
+    }
+  }
+  // stride是32的倍数，每次处理32个int8：两次相乘相加各得到8个int32，
+  // 两条乘法互不依赖，可以同时执行
+  for (int i = 0; i < stride; i += 32) {
+    __m256i xLow[2], xHigh[2];
+    for (int v = 0; v < vectors; v++) {
+      xLow[v] = load_i8x16(x + (size_t)v * stride + i);
+      xHigh[v] = load_i8x16(x + (size_t)v * stride + i + 16);
+    }
+    for (int k = 0; k < 4; k++) {
+      __m256i wLow = load_i8x16(row + k * stride + i);
+      __m256i wHigh = load_i8x16(row + k * stride + i + 16);
+      for (int v = 0; v < vectors; v++) {
+        sum[v][k] = _mm256_add_epi32(
+            sum[v][k], _mm256_add_epi32(_mm256_madd_epi16(wLow, xLow[v]),
+                                        _mm256_madd_epi16(wHigh, xHigh[v])));
+      }
+    }
+  }
+  for (int v = 0; v < vectors; v++) {
+    __m128i total =
+        policy_reduce4_epi32_avx2(sum[v][0], sum[v][1], sum[v][2], sum[v][3]);
+    _mm_storeu_ps(y + (size_t)v * ldy, _mm_cvtepi32_ps(total));
+  }
+}
+
+static void matmul_i8_avx2(const int8_t *w, int stride, int rows,
+                           const int8_t *x, int count, float *y, int ldy) {
+  for (int r = 0; r < rows; r += 4) {
+    const int8_t *row = w + (size_t)r * stride;
+    int b = 0;
+    for (; b + 2 <= count; b += 2) {
+      dot4_i8_avx2(row, stride, x + (size_t)b * stride, 2,
+                   y + (size_t)b * ldy + r, ldy);
+    }
+    if (b < count) {
+      dot4_i8_avx2(row, stride, x + (size_t)b * stride, 1,
+                   y + (size_t)b * ldy + r, ldy);
+    }
+  }
+}
+
+static const PolicyKernels avx2Kernels = {matmul_f32_avx2, matmul_i8_avx2};
+const PolicyKernels *const policyKernelsAvx2 = &avx2Kernels;
+#else
+const PolicyKernels *const policyKernelsAvx2 = NULL;
+#endif
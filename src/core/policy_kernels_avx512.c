@@ -0,0 +1,122 @@
+#include "core/policy_kernels.h"
+#include <stddef.h>
+
+// 由src/CMakeLists.txt以-mavx512f -mavx512bw -mavx512vl编译
+#if defined(__AVX512F__) && defined(__AVX512BW__)
+#include <immintrin.h>
+
+// 16个分量的高低两半相加，之后用policy_reduce4_*_avx2归约
+static inline __m256 fold_ps(__m512 v) {
+  __m256 high =
+      _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(v), 1));
+  return _mm256_add_ps(_mm512_castps512_ps256(v), high);
+}
+
+static inline __m256i fold_epi32(__m512i v) {
+  return _mm256_add_epi32(_mm512_castsi512_si256(v),
+                          _mm512_extracti64x4_epi64(v, 1));
+}
+
+// 4行与vectors（1或2）个向量的点积，内联后vectors为常量
+POLICY_KERNEL_INLINE void dot4_f32_avx512(const float *row, int stride,
+                                          const float *x, int vectors, float *y,
+                                          int ldy) {
+  __m512 sum[2][4];
+  for (int v = 0; v < vectors; v++) {
+    for (int k = 0; k < 4; k++) {
+      sum[v][k] = _mm512_setzero_ps();
+    }
+  }
+  for (int i = 0; i < stride; i += 16) {
+    __m512 vx[2];
+    for (int v = 0; v < vectors; v++) {
+      vx[v] = _mm512_loadu_ps(x + (size_t)v * stride + i);
+    }
+    for (int k = 0; k < 4; k++) {
+      __m512 vw = _mm512_loadu_ps(row + k * stride + i);
+      for (int v = 0; v < vectors; v++) {
+        sum[v][k] = _mm512_add_ps(sum[v][k], _mm512_mul_ps(vw, vx[v]));
+      }
+    }
+  }
+  for (int v = 0; v < vectors; v++) {
+    _mm_storeu_ps(y + (size_t)v * ldy,
+                  policy_reduce4_ps_avx2(fold_ps(sum[v][0]), fold_ps(sum[v][1]),
+                                         fold_ps(sum[v][2]),
+                                         fold_ps(sum[v][3])));
+  }
+}
+
+static void matmul_f32_avx512(const float *w, int stride, int rows,
+                              const float *x, int count, float *y, int ldy) {
+  for (int r = 0; r < rows; r += 4) {
+    const float *row = w + (size_t)r * stride;
+    int b = 0;
+    for (; b + 2 <= count; b += 2) {
+      dot4_f32_avx512(row, stride, x + (size_t)b * stride, 2,
+                      y + (size_t)b * ldy + r, ldy);
+    }
+    if (b < count) {
+      dot4_f32_avx512(row, stride, x + (size_t)b * stride, 1,
+                      y + (size_t)b * ldy + r, ldy);
+    }
+  }
+}
+
+// 32个int8符号扩展为32个int16
+static inline __m512i load_i8x32(const int8_t *p) {
+  return _mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i *)p));
+}
+
+POLICY_KERNEL_INLINE void dot4_i8_avx512(const int8_t *row, int stride,
+                                         const int8_t *x, int vectors, float *y,
+                                         int ldy) {
+  __m512i sum[2][4];
+  for (int v = 0; v < vectors; v++) {
+    for (int k = 0; k < 4; k++) {
+      sum[v][k] = _mm512_setzero_si512();
+    }
+  }
+  for (int i = 0; i < stride; i += 32) {
+    // 相乘相加得到16个int32
+    __m512i vx[2];
+    for (int v = 0; v < vectors; v++) {
+      vx[v] = load_i8x32(x + (size_t)v * stride + i);
+    }
+    for (int k = 0; k < 4; k++) {
+      __m512i vw = load_i8x32(row + k * stride + i);
+      for (int v = 0; v < vectors; v++) {
+        sum[v][k] = _mm512_add_epi32(sum[v][k], _mm512_madd_epi16(vw, vx[v]));
+      }
+    }
+  }
+  for (int v = 0; v < vectors; v++) {
+    __m128i total = policy_reduce4_epi32_avx2(
+        fold_epi32(sum[v][0]), fold_epi32(sum[v][1]), fold_epi32(sum[v][2]),
+        fold_epi32(sum[v][3]));
+    _mm_storeu_ps(y + (size_t)v * ldy, _mm_cvtepi32_ps(total));
+  }
+}
+
+static void matmul_i8_avx512(const int8_t *w, int stride, int rows,
+                             const int8_t *x, int count, float *y, int ldy) {
+  for (int r = 0; r < rows; r += 4) {
+    const int8_t *row = w + (size_t)r * stride;
+    int b = 0;
+    for (; b + 2 <= count; b += 2) {
+      dot4_i8_avx512(row, stride, x + (size_t)b * stride, 2,
+                     y + (size_t)b * ldy + r, ldy);
+    }
+    if (b < count) {
+      dot4_i8_avx512(row, stride, x + (size_t)b * stride, 1,
+                     y + (size_t)b * ldy + r, ldy);
+    }
+  }
+}
+
+static const PolicyKernels avx512Kernels = {matmul_f32_avx512,
+                                            matmul_i8_avx512};
+const PolicyKernels *const policyKernelsAvx512 = &avx512Kernels;
+#else
+const PolicyKernels *const policyKernelsAvx512 = NULL;
+#endif
@@ -0,0 +1,67 @@
+#include "core/policy_kernels.h"
+#include <stddef.h>
+
+// 由src/CMakeLists.txt以-msse4.2编译
+#if defined(__SSE4_2__)
+#include <smmintrin.h>
+
+// 8个int8符号扩展为int16
+static inline __m128i load_i8x8(const int8_t *p) {
+  return _mm_cvtepi8_epi16(_mm_loadl_epi64((const __m128i *)p));
+}
+
+// 与SSE2版相比，权重用pmovsxbw代替解包和移位
+POLICY_KERNEL_INLINE void dot4_i8_sse42(const int8_t *row, int stride,
+                                        const int8_t *x, int vectors, float *y,
+                                        int ldy) {
+  __m128i sum[2][4];
+  for (int v = 0; v < vectors; v++) {
+    for (int k = 0; k < 4; k++) {
+      sum[v][k] = _mm_setzero_si128();
+    }
+  }
+  for (int i = 0; i < stride; i += 16) {
+    __m128i xLow[2], xHigh[2];
+    for (int v = 0; v < vectors; v++) {
+      xLow[v] = load_i8x8(x + (size_t)v * stride + i);
+      xHigh[v] = load_i8x8(x + (size_t)v * stride + i + 8);
+    }
+    for (int k = 0; k < 4; k++) {
+      __m128i wLow = load_i8x8(row + k * stride + i);
+      __m128i wHigh = load_i8x8(row + k * stride + i + 8);
+      for (int v = 0; v < vectors; v++) {
+        sum[v][k] = _mm_add_epi32(
+            sum[v][k], _mm_add_epi32(_mm_madd_epi16(wLow, xLow[v]),
+                                     _mm_madd_epi16(wHigh, xHigh[v])));
+      }
+    }
+  }
+  for (int v = 0; v < vectors; v++) {
+    __m128i total =
+        policy_reduce4_epi32(sum[v][0], sum[v][1], sum[v][2], sum[v][3]);
+    _mm_storeu_ps(y + (size_t)v * ldy, _mm_cvtepi32_ps(total));
+  }
+}
+
+static void matmul_i8_sse42(const int8_t *w, int stride, int rows,
+                            const int8_t *x, int count, float *y, int ldy) {
+  for (int r = 0; r < rows; r += 4) {
+    const int8_t *row = w + (size_t)r * stride;
+    int b = 0;
+    for (; b + 2 <= count; b += 2) {
+      dot4_i8_sse42(row, stride, x + (size_t)b * stride, 2,
+                    y + (size_t)b * ldy + r, ldy);
+    }
+    if (b < count) {
+      dot4_i8_sse42(row, stride, x + (size_t)b * stride, 1,
+                    y + (size_t)b * ldy + r, ldy);
+    }
+  }
+}
+
+static const PolicyKernels sse42Kernels = {policy_matmul_f32_sse2,
+                                           matmul_i8_sse42};
+const PolicyKernels *const policyKernelsSse42 = &sse42Kernels;
+#else
+const PolicyKernels *const policyKernelsSse42 = NULL;
+#endif
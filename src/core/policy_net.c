@@ -0,0 +1,358 @@
+#include "core/policy_net.h"
+#include "core/cpu_dispatch.h"
+#include "core/policy_kernels.h"
+#include "utils/memory.h"
+#include <SDL3/SDL.h>
+#include <math.h>
+#include <stdio.h>
+
+// 层数和单层宽度的上限，防止损坏的文件导致巨大的分配
+#define POLICY_MAX_LAYERS 16
+#define POLICY_MAX_WIDTH 4096
+
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t layerCount;
+} PolicyFileHeader;
+
+typedef struct {
+  uint32_t inputs;
+  uint32_t outputs;
+  uint32_t type;
+  uint32_t activation;
+} PolicyLayerHeader;
+
+// ---------------- 矩阵乘内核 ----------------
+
+// 第一次加载网络时按CPU选择一次
+static const PolicyKernels *kernels = NULL;
+
+static void select_kernels(void) {
+  if (__atomic_load_n(&kernels, __ATOMIC_ACQUIRE) != NULL) {
+    return;
+  }
+  // 按优先顺序排列
+  const CpuKernelVariant variants[] = {
+      {"avx512", CPU_FEATURE_AVX512, policyKernelsAvx512},
+      {"avx2", CPU_FEATURE_AVX2, policyKernelsAvx2},
+      {"sse4.2", CPU_FEATURE_SSE42, policyKernelsSse42},
+      {"sse2", CPU_FEATURE_SSE2, policyKernelsSse2},
+      {"scalar", 0, policyKernelsScalar},
+  };
+  const PolicyKernels *selected = select_cpu_kernels(
+      "策略网络", variants, sizeof(variants) / sizeof(variants[0]));
+  __atomic_store_n(&kernels, selected, __ATOMIC_RELEASE);
+}
+
+// ---------------- 加载 ----------------
+
+static inline int round_up_stride(int count) {
+  return (count + POLICY_ROW_ALIGN - 1) / POLICY_ROW_ALIGN * POLICY_ROW_ALIGN;
+}
+
+// 内核一次处理4行，行数补齐到4的倍数，补齐的行全为0
+static inline int round_up_rows(int count) { return (count + 3) / 4 * 4; }
+
+static bool read_exact(FILE *file, void *buffer, size_t size) {
+  return fread(buffer, 1, size, file) == size;
+}
+
+// 按行读取到已清零的缓冲中，每行stride个元素，行尾保持为0
+static bool read_rows(FILE *file, void *rows, int outputs, int inputs,
+                      int stride, size_t elementSize) {
+  unsigned char *bytes = (unsigned char *)rows;
+  for (int o = 0; o < outputs; o++) {
+    if (!read_exact(file, bytes + (size_t)o * stride * elementSize,
+                    (size_t)inputs * elementSize)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool load_layer(PolicyLayer *layer, FILE *file, int expectedInputs) {
+  PolicyLayerHeader header;
+  if (!read_exact(file, &header, sizeof(header)) ||
+      (int)header.inputs != expectedInputs || header.outputs < 1 ||
+      header.outputs > POLICY_MAX_WIDTH || header.type > POLICY_LAYER_INT8 ||
+      header.activation > POLICY_ACTIVATION_RELU) {
+    return false;
+  }
+
+  layer->inputs = (int)header.inputs;
+  layer->outputs = (int)header.outputs;
+  layer->stride = round_up_stride(layer->inputs);
+  layer->type = (PolicyLayerType)header.type;
+  layer->activation = (PolicyActivation)header.activation;
+  layer->bias = NEW_ARRAY(float, layer->outputs);
+
+  if (layer->type == POLICY_LAYER_FP32) {
+    layer->weights = NEW_ARRAY_ZEROED(
+        float, (size_t)round_up_rows(layer->outputs) * layer->stride);
+    return read_rows(file, layer->weights, layer->outputs, layer->inputs,
+                     layer->stride, sizeof(float)) &&
+           read_exact(file, layer->bias, sizeof(float) * layer->outputs);
+  }
+
+  layer->scales = NEW_ARRAY(float, layer->outputs);
+  layer->quantized = NEW_ARRAY_ZEROED(
+      int8_t, (size_t)round_up_rows(layer->outputs) * layer->stride);
+  return read_exact(file, layer->scales, sizeof(float) * layer->outputs) &&
+         read_rows(file, layer->quantized, layer->outputs, layer->inputs,
+                   layer->stride, sizeof(int8_t)) &&
+         read_exact(file, layer->bias, sizeof(float) * layer->outputs);
+}
+
+bool load_policy_net(PolicyNet *net, const char *path) {
+  memset(net, 0, sizeof(*net));
+
+  FILE *file = fopen(path, "rb");
+  if (file == NULL) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "无法打开策略网络: %s", path);
+    return false;
+  }
+
+  PolicyFileHeader header;
+  bool ok = read_exact(file, &header, sizeof(header)) &&
+            header.magic == POLICY_NET_MAGIC &&
+            header.version == POLICY_NET_VERSION && header.layerCount >= 1 &&
+            header.layerCount <= POLICY_MAX_LAYERS;
+  if (ok) {
+    net->layerCount = (int)header.layerCount;
+    net->layers = NEW_ARRAY_ZEROED(PolicyLayer, net->layerCount);
+  }
+
+  int width = POLICY_FEATURE_COUNT;
+  for (int i = 0; ok && i < net->layerCount; i++) {
+    ok = load_layer(&net->layers[i], file, width);
+    width = net->layers[i].outputs;
+  }
+  // 末尾不能有多余的数据
+  ok = ok && width == 4 && fgetc(file) == EOF;
+  fclose(file);
+
+  if (!ok) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "策略网络格式错误: %s", path);
+    cleanup_policy_net(net);
+    return false;
+  }
+
+  net->maxStride = round_up_stride(POLICY_FEATURE_COUNT);
+  for (int i = 0; i < net->layerCount; i++) {
+    int outputs = round_up_stride(net->layers[i].outputs);
+    if (outputs > net->maxStride) {
+      net->maxStride = outputs;
+    }
+  }
+  const size_t batchSize = (size_t)POLICY_BATCH_SIZE * net->maxStride;
+  net->activations[0] = NEW_ARRAY_ZEROED(float, batchSize);
+  net->activations[1] = NEW_ARRAY_ZEROED(float, batchSize);
+  net->quantizedInput = NEW_ARRAY_ZEROED(int8_t, batchSize);
+
+  select_kernels();
+  return true;
+}
+
+void cleanup_policy_net(PolicyNet *net) {
+  for (int i = 0; i < net->layerCount && net->layers != NULL; i++) {
+    PolicyLayer *layer = &net->layers[i];
+    FREE(layer->weights);
+    FREE(layer->quantized);
+    FREE(layer->scales);
+    FREE(layer->bias);
+  }
+  FREE(net->layers);
+  FREE(net->activations[0]);
+  FREE(net->activations[1]);
+  FREE(net->quantizedInput);
+  net->layerCount = 0;
+}
+
+// ---------------- 推理 ----------------
+
+// 按最大绝对值对称量化，返回缩放；补零部分保持为0
+static float quantize_input(const float *input, int count, int8_t *output) {
+  float maxAbs = 0.0f;
+  for (int i = 0; i < count; i++) {
+    float value = fabsf(input[i]);
+    if (value > maxAbs) {
+      maxAbs = value;
+    }
+  }
+  if (maxAbs == 0.0f) {
+    memset(output, 0, count);
+    return 0.0f;
+  }
+
+  // 手动四舍五入，lrintf在不开启-ffast-math时是库函数调用
+  const float inverse = 127.0f / maxAbs;
+  for (int i = 0; i < count; i++) {
+    float value = input[i] * inverse;
+    output[i] = (int8_t)(value + (value >= 0.0f ? 0.5f : -0.5f));
+  }
+  return maxAbs / 127.0f;
+}
+
+/**
+ * 对count个输入向量计算一层。输入向量之间相隔layer->stride个元素，输出向量
+ * 之间相隔输出数对齐后的长度，正好是下一层的stride
+ */
+static void run_layer(PolicyNet *net, const PolicyLayer *layer,
+                      const float *input, float *output, int count) {
+  const int rows = round_up_rows(layer->outputs);
+  const int outputStride = round_up_stride(layer->outputs);
+  if (layer->type == POLICY_LAYER_FP32) {
+    kernels->matmul_f32(layer->weights, layer->stride, rows, input, count,
+                        output, outputStride);
+  } else {
+    for (int b = 0; b < count; b++) {
+      int8_t *quantized = net->quantizedInput + (size_t)b * layer->stride;
+      net->inputScales[b] = quantize_input(
+          input + (size_t)b * layer->stride, layer->inputs, quantized);
+      memset(quantized + layer->inputs, 0, layer->stride - layer->inputs);
+    }
+    kernels->matmul_i8(layer->quantized, layer->stride, rows,
+                       net->quantizedInput, count, output, outputStride);
+  }
+
+  for (int b = 0; b < count; b++) {
+    float *vector = output + (size_t)b * outputStride;
+    if (layer->type == POLICY_LAYER_FP32) {
+      for (int o = 0; o < layer->outputs; o++) {
+        vector[o] += layer->bias[o];
+      }
+    } else {
+      const float inputScale = net->inputScales[b];
+      for (int o = 0; o < layer->outputs; o++) {
+        vector[o] = vector[o] * inputScale * layer->scales[o] + layer->bias[o];
+      }
+    }
+    if (layer->activation == POLICY_ACTIVATION_RELU) {
+      for (int o = 0; o < layer->outputs; o++) {
+        vector[o] = vector[o] > 0.0f ? vector[o] : 0.0f;
+      }
+    }
+    // 下一层按stride读取，尾部必须为0
+    memset(vector + layer->outputs, 0,
+           sizeof(float) * (outputStride - layer->outputs));
+  }
+}
+
+/**
+ * 对activations[0]中的count个特征向量（相隔对齐后的特征数）推理，
+ * 把各自的四个分数写入scores
+ */
+static void run_batch(PolicyNet *net, int count, float *scores) {
+  float *input = net->activations[0];
+  float *output = net->activations[1];
+  for (int i = 0; i < net->layerCount; i++) {
+    run_layer(net, &net->layers[i], input, output, count);
+    float *swap = input;
+    input = output;
+    output = swap;
+  }
+  // 最后一层的输出数为4
+  for (int b = 0; b < count; b++) {
+    memcpy(scores + (size_t)b * 4, input + (size_t)b * round_up_stride(4),
+           sizeof(float) * 4);
+  }
+}
+
+void policy_net_forward(PolicyNet *net, const float *features, float *scores) {
+  float *input = net->activations[0];
+  memcpy(input, features, sizeof(float) * POLICY_FEATURE_COUNT);
+  memset(input + POLICY_FEATURE_COUNT, 0,
+         sizeof(float) *
+             (round_up_stride(POLICY_FEATURE_COUNT) - POLICY_FEATURE_COUNT));
+  run_batch(net, 1, scores);
+}
+
+void extract_policy_features(const Snake *snake,
+                             const FoodManager *foodManager,
+                             const GameStateData *state, float *features) {
+  memset(features, 0, sizeof(float) * POLICY_FEATURE_COUNT);
+  if (knode_empty(&snake->head)) {
+    return;
+  }
+
+  const int width = state->config.gridWidth;
+  const int height = state->config.gridHeight;
+  int headX, headY;
+  get_snake_head(snake, &headX, &headY);
+
+  features[POLICY_FEATURE_DIRECTION + state->currentDirection] = 1.0f;
+
+  static const int deltaX[4] = {0, 0, -1, 1};
+  static const int deltaY[4] = {-1, 1, 0, 0};
+  for (int k = 0; k < 4; k++) {
+    int x = headX + deltaX[k];
+    int y = headY + deltaY[k];
+    bool fatal = x < 0 || x >= width || y < 0 || y >= height ||
+                 check_snake_collision(snake, x, y);
+    features[POLICY_FEATURE_DANGER + k] = fatal ? 1.0f : 0.0f;
+  }
+
+  int nearest = -1;
+  int foodX = headX, foodY = headY;
+  const KNode *node;
+  knode_for_each(node, &foodManager->head) {
+    const Food *food = container_of(node, Food, node);
+    int distance = abs(food->x - headX) + abs(food->y - headY);
+    if (nearest < 0 || distance < nearest) {
+      nearest = distance;
+      foodX = food->x;
+      foodY = food->y;
+    }
+  }
+  if (nearest >= 0) {
+    features[POLICY_FEATURE_FOOD + DIRECTION_UP] = foodY < headY;
+    features[POLICY_FEATURE_FOOD + DIRECTION_DOWN] = foodY > headY;
+    features[POLICY_FEATURE_FOOD + DIRECTION_LEFT] = foodX < headX;
+    features[POLICY_FEATURE_FOOD + DIRECTION_RIGHT] = foodX > headX;
+    features[POLICY_FEATURE_FOOD_DX] = (float)(foodX - headX) / width;
+    features[POLICY_FEATURE_FOOD_DY] = (float)(foodY - headY) / height;
+  }
+
+  features[POLICY_FEATURE_HEAD_X] = (float)headX / width;
+  features[POLICY_FEATURE_HEAD_Y] = (float)headY / height;
+  features[POLICY_FEATURE_LENGTH] = (float)snake->length / (width * height);
+}
+
+void policy_net_forward_batch(PolicyNet *net, const Game *const *games,
+                              int count, float *scores) {
+  const int stride = round_up_stride(POLICY_FEATURE_COUNT);
+  for (int first = 0; first < count; first += POLICY_BATCH_SIZE) {
+    const int batch = count - first < POLICY_BATCH_SIZE ? count - first
+                                                        : POLICY_BATCH_SIZE;
+    for (int b = 0; b < batch; b++) {
+      const Game *game = games[first + b];
+      float *features = net->activations[0] + (size_t)b * stride;
+      extract_policy_features(&game->snake, &game->foodManager, &game->state,
+                              features);
+      memset(features + POLICY_FEATURE_COUNT, 0,
+             sizeof(float) * (stride - POLICY_FEATURE_COUNT));
+    }
+    run_batch(net, batch, scores + (size_t)first * 4);
+  }
+}
+
+Direction policy_net_choose(PolicyNet *net, const Game *game) {
+  float scores[4];
+  policy_net_forward_batch(net, &game, 1, scores);
+
+  const Direction current = game->state.currentDirection;
+  Direction best = current;
+  float bestScore = -INFINITY;
+  for (int k = 0; k < 4; k++) {
+    // 反向会被change_direction忽略
+    if ((k ^ 1) == (int)current) {
+      continue;
+    }
+    if (scores[k] > bestScore) {
+      best = (Direction)k;
+      bestScore = scores[k];
+    }
+  }
+  return best;
+}
@@ -0,0 +1,288 @@
+#include "core/search_state.h"
+#include "core/step_rules.h"
+#include "core/zobrist.h"
+#include <stddef.h>
+#include <string.h>
+
+#define BODY_MASK (SEARCH_MAX_CELLS - 1)
+
+static inline bool test_bit(const uint64_t *bits, int cell) {
+  return (bits[cell >> 6] >> (cell & 63)) & 1;
+}
+
+static inline void set_bit(uint64_t *bits, int cell) {
+  bits[cell >> 6] |= 1ULL << (cell & 63);
+}
+
+static inline void clear_bit(uint64_t *bits, int cell) {
+  bits[cell >> 6] &= ~(1ULL << (cell & 63));
+}
+
+static inline bool is_reverse(Direction a, Direction b) {
+  return (a == DIRECTION_UP && b == DIRECTION_DOWN) ||
+         (a == DIRECTION_DOWN && b == DIRECTION_UP) ||
+         (a == DIRECTION_LEFT && b == DIRECTION_RIGHT) ||
+         (a == DIRECTION_RIGHT && b == DIRECTION_LEFT);
+}
+
+static inline uint64_t cell_key(const SearchState *state, int cell,
+                                ZobristPiece piece) {
+  return zobrist_cell_key(cell % state->gridWidth, cell / state->gridWidth,
+                          piece);
+}
+
+// 蛇身一节的键：cell处的一节通向前一节next
+static inline uint64_t link_key(const SearchState *state, int cell, int next) {
+  const int width = state->gridWidth;
+  return zobrist_body_key(cell % width, cell / width, next % width,
+                          next / width);
+}
+
+static void add_food(SearchState *state, int cell) {
+  state->foods[state->foodCount++] = (uint16_t)cell;
+  set_bit(state->foodBits, cell);
+  state->hash ^= cell_key(state, cell, ZOBRIST_FOOD);
+}
+
+static void remove_food_at(SearchState *state, int cell) {
+  for (int i = 0; i < state->foodCount; i++) {
+    if (state->foods[i] == cell) {
+      state->foods[i] = state->foods[--state->foodCount];
+      break;
+    }
+  }
+  clear_bit(state->foodBits, cell);
+  state->hash ^= cell_key(state, cell, ZOBRIST_FOOD);
+}
+
+// 第pick个（从0开始）既不是蛇身也不是食物的格子
+static int find_free_cell(const SearchState *state, int pick) {
+  for (int w = 0; w < state->words; w++) {
+    uint64_t free = ~(state->occupied[w] | state->foodBits[w]);
+    int count = __builtin_popcountll(free);
+    if (pick >= count) {
+      pick -= count;
+      continue;
+    }
+    while (pick-- > 0) {
+      free &= free - 1;
+    }
+    return w * 64 + __builtin_ctzll(free);
+  }
+  return -1;
+}
+
+// 以下是step_rules.h中规则的回调
+
+static inline int cell_at(const SearchState *state, int x, int y) {
+  return y * state->gridWidth + x;
+}
+
+static bool search_is_free(StepContext context, int x, int y) {
+  const SearchState *state = (const SearchState *)context;
+  const int cell = cell_at(state, x, y);
+  return !test_bit(state->occupied, cell) && !test_bit(state->foodBits, cell);
+}
+
+static int search_count_free(StepContext context) {
+  const SearchState *state = (const SearchState *)context;
+  // 最后一个字中网格之外的位视为已占用
+  int taken = state->words * 64 - state->gridWidth * state->gridHeight;
+  for (int w = 0; w < state->words; w++) {
+    taken += __builtin_popcountll(state->occupied[w] | state->foodBits[w]);
+  }
+  return state->words * 64 - taken;
+}
+
+static void search_find_free(StepContext context, int pick, int *x, int *y) {
+  const SearchState *state = (const SearchState *)context;
+  const int cell = find_free_cell(state, pick);
+  *x = cell % state->gridWidth;
+  *y = cell / state->gridWidth;
+}
+
+static void search_add_food(StepContext context, int x, int y) {
+  SearchState *state = (SearchState *)context;
+  add_food(state, cell_at(state, x, y));
+}
+
+static const FoodSpawnRules searchSpawnRules = {
+    search_is_free,
+    search_count_free,
+    search_find_free,
+    search_add_food,
+};
+
+static bool search_has_food(StepContext context, int x, int y) {
+  const SearchState *state = (const SearchState *)context;
+  return test_bit(state->foodBits, cell_at(state, x, y));
+}
+
+static bool search_is_occupied(StepContext context, int x, int y) {
+  const SearchState *state = (const SearchState *)context;
+  return test_bit(state->occupied, cell_at(state, x, y));
+}
+
+static void search_advance(StepContext context, int x, int y, bool grow) {
+  SearchState *state = (SearchState *)context;
+  const int headCell = state->body[state->head];
+  const int cell = cell_at(state, x, y);
+  if (grow) {
+    state->length++;
+  } else {
+    // 蛇尾指向前一节；只有一节时前一节就是新蛇头
+    int tail = (state->head + state->length - 1) & BODY_MASK;
+    int next = state->length > 1 ? state->body[(tail - 1) & BODY_MASK] : cell;
+    clear_bit(state->occupied, state->body[tail]);
+    state->hash ^= link_key(state, state->body[tail], next);
+  }
+  // 旧蛇头成为指向新蛇头的一节
+  state->hash ^= cell_key(state, headCell, ZOBRIST_HEAD) ^
+                 link_key(state, headCell, cell) ^
+                 cell_key(state, cell, ZOBRIST_HEAD);
+  state->head = (state->head - 1) & BODY_MASK;
+  state->body[state->head] = (uint16_t)cell;
+  set_bit(state->occupied, cell);
+}
+
+static int search_eat_food(StepContext context, int x, int y) {
+  SearchState *state = (SearchState *)context;
+  remove_food_at(state, cell_at(state, x, y));
+  return 1; // 与add_food放置的食物一样，每个得1分
+}
+
+static void search_spawn_food(StepContext context) {
+  SearchState *state = (SearchState *)context;
+  if (state->foodCount < state->maxFoodCount) {
+    place_food_by_rules(&searchSpawnRules, state, state->gridWidth,
+                        state->gridHeight, &state->rngState);
+  }
+}
+
+static const StepRules searchStepRules = {
+    search_has_food, search_is_occupied, search_advance, search_eat_food,
+    search_spawn_food,
+};
+
+static int next_cell(const SearchState *state, Direction direction) {
+  const int cell = state->body[state->head];
+  int x = cell % state->gridWidth;
+  int y = cell / state->gridWidth;
+  switch (direction) {
+  case DIRECTION_UP:
+    y--;
+    break;
+  case DIRECTION_DOWN:
+    y++;
+    break;
+  case DIRECTION_LEFT:
+    x--;
+    break;
+  case DIRECTION_RIGHT:
+    x++;
+    break;
+  }
+  if (x < 0 || x >= state->gridWidth || y < 0 || y >= state->gridHeight) {
+    return -1;
+  }
+  return y * state->gridWidth + x;
+}
+
+bool load_search_state(SearchState *state, const Game *game) {
+  const GameConfig *config = &game->state.config;
+  const int cellCount = config->gridWidth * config->gridHeight;
+  if (cellCount <= 0 || cellCount > SEARCH_MAX_CELLS ||
+      game->foodManager.maxCount > SEARCH_MAX_FOOD ||
+      knode_empty(&game->snake.head)) {
+    return false;
+  }
+
+  state->gridWidth = config->gridWidth;
+  state->gridHeight = config->gridHeight;
+  state->words = (cellCount + 63) / 64;
+  state->length = 0;
+  state->head = 0;
+  state->score = game->state.score;
+  state->direction = game->state.currentDirection;
+  state->alive = game->snake.isAlive;
+  state->foodCount = 0;
+  state->maxFoodCount = game->foodManager.maxCount;
+  state->rngState = game->foodManager.rngState;
+  state->hash = 0;
+  memset(state->occupied, 0, sizeof(uint64_t) * state->words);
+  memset(state->foodBits, 0, sizeof(uint64_t) * state->words);
+
+  const KNode *node;
+  knode_for_each(node, &game->snake.head) {
+    const SnakeSegment *segment = container_of(node, SnakeSegment, node);
+    if (segment->x < 0 || segment->x >= state->gridWidth || segment->y < 0 ||
+        segment->y >= state->gridHeight) {
+      return false;
+    }
+    int cell = segment->y * state->gridWidth + segment->x;
+    state->hash ^= state->length == 0
+                       ? cell_key(state, cell, ZOBRIST_HEAD)
+                       : link_key(state, cell, state->body[state->length - 1]);
+    state->body[state->length++] = (uint16_t)cell;
+    set_bit(state->occupied, cell);
+  }
+
+  // 食物链表新生成的在前，按从旧到新的顺序加入，保持与游戏一致的位置集合
+  knode_for_each_reverse(node, &game->foodManager.head) {
+    const Food *food = container_of(node, Food, node);
+    if (state->foodCount < SEARCH_MAX_FOOD) {
+      add_food(state, food->y * state->gridWidth + food->x);
+    }
+  }
+  return true;
+}
+
+void copy_search_state(SearchState *dst, const SearchState *src) {
+  memcpy(dst, src, offsetof(SearchState, occupied));
+  memcpy(dst->occupied, src->occupied, sizeof(uint64_t) * src->words);
+  memcpy(dst->foodBits, src->foodBits, sizeof(uint64_t) * src->words);
+
+  // 只复制环形缓冲中有效的一段（可能绕回开头）
+  const int first = src->length < SEARCH_MAX_CELLS - src->head
+                        ? src->length
+                        : SEARCH_MAX_CELLS - src->head;
+  memcpy(dst->body + src->head, src->body + src->head,
+         sizeof(uint16_t) * first);
+  memcpy(dst->body, src->body, sizeof(uint16_t) * (src->length - first));
+}
+
+bool is_search_move_fatal(const SearchState *state, Direction direction) {
+  if (is_reverse(direction, state->direction)) {
+    direction = state->direction;
+  }
+  const int cell = next_cell(state, direction);
+  return cell < 0 || test_bit(state->occupied, cell);
+}
+
+bool step_search_state(SearchState *state, Direction direction) {
+  if (!state->alive) {
+    return false;
+  }
+  if (!is_reverse(direction, state->direction)) {
+    state->direction = direction;
+  }
+
+  // 规则与step_game共用
+  int headX, headY;
+  get_search_head(state, &headX, &headY);
+  state->alive = step_by_rules(&searchStepRules, state, headX, headY,
+                               state->direction, state->gridWidth,
+                               state->gridHeight, &state->score);
+  return state->alive;
+}
+
+void get_search_head(const SearchState *state, int *x, int *y) {
+  const int cell = state->body[state->head];
+  *x = cell % state->gridWidth;
+  *y = cell / state->gridWidth;
+}
+
+uint64_t search_state_hash(const SearchState *state) {
+  return state->hash ^ zobrist_direction_key(state->direction) ^
+         zobrist_score_key(state->score);
+}
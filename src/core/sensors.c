@@ -0,0 +1,125 @@
+#include "core/sensors.h"
+#include "core/bitboard.h"
+#include <string.h>
+
+// 过蛇头的四条线，行、对角线和反对角线按X坐标取位，列按Y坐标取位
+typedef struct {
+  uint64_t row;          // 与蛇头同一行
+  uint64_t column;       // 与蛇头同一列
+  uint64_t diagonal;     // 左上到右下（x - y与蛇头相同）
+  uint64_t antiDiagonal; // 左下到右上（x + y与蛇头相同）
+} SensorLines;
+
+// 把格子投影到过蛇头的四条线上，不在线上的格子移入的是0，无需分支
+static inline void project_cell(SensorLines *lines, int headX, int headY,
+                                int x, int y) {
+  const int dx = x - headX;
+  const int dy = y - headY;
+  lines->row |= (uint64_t)(dy == 0) << x;
+  lines->column |= (uint64_t)(dx == 0) << y;
+  lines->diagonal |= (uint64_t)(dx == dy) << x;
+  lines->antiDiagonal |= (uint64_t)(dx == -dy) << x;
+}
+
+// 线上位于position之后（更高位）最近的置位的距离，没有时为0
+static inline int distance_after(uint64_t line, int position) {
+  // 分两次移位，position为63时不会移出64位
+  const uint64_t ahead = line >> position >> 1;
+  return ahead != 0 ? __builtin_ctzll(ahead) + 1 : 0;
+}
+
+// 线上位于position之前（更低位）最近的置位的距离，没有时为0
+static inline int distance_before(uint64_t line, int position) {
+  const uint64_t behind = line & ((1ULL << position) - 1);
+  return behind != 0 ? position - 63 + __builtin_clzll(behind) : 0;
+}
+
+// 沿8条射线求最近置位的距离，按SensorRay顺序输出
+static void cast_rays(const SensorLines *lines, int headX, int headY,
+                      int distances[SENSOR_RAY_COUNT]) {
+  distances[SENSOR_RAY_UP] = distance_before(lines->column, headY);
+  distances[SENSOR_RAY_DOWN] = distance_after(lines->column, headY);
+  distances[SENSOR_RAY_LEFT] = distance_before(lines->row, headX);
+  distances[SENSOR_RAY_RIGHT] = distance_after(lines->row, headX);
+  distances[SENSOR_RAY_UP_LEFT] = distance_before(lines->diagonal, headX);
+  distances[SENSOR_RAY_UP_RIGHT] = distance_after(lines->antiDiagonal, headX);
+  distances[SENSOR_RAY_DOWN_LEFT] =
+      distance_before(lines->antiDiagonal, headX);
+  distances[SENSOR_RAY_DOWN_RIGHT] = distance_after(lines->diagonal, headX);
+}
+
+static inline int min_int(int a, int b) { return a < b ? a : b; }
+
+static inline float inverse_distance(int distance) {
+  return distance > 0 ? 1.0f / (float)distance : 0.0f;
+}
+
+// 输出已清零，失败时保持全0
+static bool write_sensors(const Game *game, float *sensors) {
+  const Snake *snake = &game->snake;
+  const int width = game->state.config.gridWidth;
+  const int height = game->state.config.gridHeight;
+  if (knode_empty(&snake->head) || width > BITBOARD_MAX_SIZE ||
+      height > BITBOARD_MAX_SIZE) {
+    return false;
+  }
+
+  int headX, headY;
+  get_snake_head(snake, &headX, &headY);
+
+  // 蛇身与check_snake_collision使用相同的占用（含蛇尾）
+  SensorLines body = {0};
+  const KNode *node;
+  knode_for_each(node, &snake->head) {
+    const SnakeSegment *segment = container_of(node, SnakeSegment, node);
+    if (segment->x >= 0 && segment->x < width && segment->y >= 0 &&
+        segment->y < height) {
+      project_cell(&body, headX, headY, segment->x, segment->y);
+    }
+  }
+  // 蛇头在四条线上，射线只看它前方的格子，无需清除
+
+  SensorLines food = {0};
+  knode_for_each(node, &game->foodManager.head) {
+    const Food *item = container_of(node, Food, node);
+    project_cell(&food, headX, headY, item->x, item->y);
+  }
+
+  const int up = headY + 1;
+  const int down = height - headY;
+  const int left = headX + 1;
+  const int right = width - headX;
+  const int walls[SENSOR_RAY_COUNT] = {
+      up, down, left, right, min_int(up, left), min_int(up, right),
+      min_int(down, left), min_int(down, right)};
+  int bodyDistances[SENSOR_RAY_COUNT];
+  int foodDistances[SENSOR_RAY_COUNT];
+  cast_rays(&body, headX, headY, bodyDistances);
+  cast_rays(&food, headX, headY, foodDistances);
+
+  for (int ray = 0; ray < SENSOR_RAY_COUNT; ray++) {
+    float *values = sensors + ray * SENSOR_TARGET_COUNT;
+    values[SENSOR_TARGET_WALL] = inverse_distance(walls[ray]);
+    values[SENSOR_TARGET_BODY] = inverse_distance(bodyDistances[ray]);
+    values[SENSOR_TARGET_FOOD] = inverse_distance(foodDistances[ray]);
+  }
+  return true;
+}
+
+bool extract_ray_sensors(const Game *game, float *sensors) {
+  return extract_ray_sensors_batch(&game, 1, sensors) == 1;
+}
+
+int extract_ray_sensors_batch(const Game *const *games, int count,
+                              float *sensors) {
+  if (count <= 0) {
+    return 0;
+  }
+
+  memset(sensors, 0, sizeof(float) * SENSOR_COUNT * count);
+  int succeeded = 0;
+  for (int i = 0; i < count; i++) {
+    succeeded += write_sensors(games[i], sensors + (size_t)SENSOR_COUNT * i);
+  }
+  return succeeded;
+}
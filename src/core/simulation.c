@@ -0,0 +1,290 @@
+#include "core/simulation.h"
+#include "utils/memory.h"
+
+// middle中标记"有未读取的新快照"的位
+#define SNAPSHOT_FRESH 4
+#define SNAPSHOT_INDEX_MASK 3
+// 落后超过该时间（纳秒）时放弃追赶，避免长时间卡顿后连续补帧
+#define SIM_MAX_LAG_NS 250000000ULL
+
+// 把蛇身复制到cells中，返回格子数量
+static int copy_snake_cells(GridCell *cells, const Game *game) {
+  const GameConfig *config = &game->state.config;
+  const int cellCapacity = config->gridWidth * config->gridHeight;
+
+  int count = 0;
+  const KNode *node;
+  knode_for_each(node, &game->snake.head) {
+    if (count >= cellCapacity) {
+      break;
+    }
+    const SnakeSegment *segment = container_of(node, SnakeSegment, node);
+    cells[count].x = segment->x;
+    cells[count].y = segment->y;
+    count++;
+  }
+  return count;
+}
+
+// 记录逻辑步进后的蛇身；ticked为false时表示棋盘被重置，两次记录都指向当前位置
+static void record_tick_cells(Simulation *sim, bool ticked) {
+  if (ticked) {
+    GridCell *older = sim->tickCells[0];
+    sim->tickCells[0] = sim->tickCells[1];
+    sim->tickLength[0] = sim->tickLength[1];
+    sim->tickCells[1] = older;
+  }
+  sim->tickLength[1] = copy_snake_cells(sim->tickCells[1], &sim->game);
+  if (!ticked) {
+    memcpy(sim->tickCells[0], sim->tickCells[1],
+           sizeof(GridCell) * sim->tickLength[1]);
+    sim->tickLength[0] = sim->tickLength[1];
+  }
+}
+
+static void fill_snapshot(GameSnapshot *snapshot, const Simulation *sim,
+                          Uint64 tickTimeNS) {
+  fill_game_snapshot(snapshot, &sim->game);
+  memcpy(snapshot->previousCells, sim->tickCells[0],
+         sizeof(GridCell) * sim->tickLength[0]);
+  snapshot->previousLength = sim->tickLength[0];
+  snapshot->tickTimeNS = tickTimeNS;
+}
+
+// 写入后台缓冲并与中间缓冲交换
+static void publish_snapshot(Simulation *sim, Uint64 tickTimeNS) {
+  fill_snapshot(&sim->snapshots[sim->writeIndex], sim, tickTimeNS);
+  int previous =
+      SDL_SetAtomicInt(&sim->middle, sim->writeIndex | SNAPSHOT_FRESH);
+  sim->writeIndex = previous & SNAPSHOT_INDEX_MASK;
+}
+
+// 取出队列中的全部输入并应用到游戏，返回是否处理了输入
+static bool drain_input(Simulation *sim) {
+  SimInputQueue *queue = &sim->input;
+  unsigned int tail = (unsigned int)SDL_GetAtomicInt(&queue->tail);
+  unsigned int head = (unsigned int)SDL_GetAtomicInt(&queue->head);
+  if (tail == head) {
+    return false;
+  }
+
+  SDL_MemoryBarrierAcquire();
+  for (; tail != head; tail++) {
+    const SimInput *input = &queue->items[tail & (SIM_INPUT_QUEUE_SIZE - 1)];
+    switch (input->type) {
+    case SIM_INPUT_DIRECTION:
+      change_direction(&sim->game.state, input->direction);
+      break;
+    case SIM_INPUT_COMMAND:
+      send_game_command(&sim->game, input->command);
+      break;
+    case SIM_INPUT_MOVE_INTERVAL:
+      sim->game.state.config.moveInterval = input->moveInterval;
+      break;
+    }
+  }
+  SDL_SetAtomicInt(&queue->tail, (int)tail);
+  return true;
+}
+
+// 记录一次更新中发生的游戏事件；游戏逻辑本身不输出日志，
+// 训练环境等其他调用者的步进循环中没有I/O
+static void log_game_events(GameState previousState, int previousScore,
+                            const Game *game) {
+  const GameStateData *state = &game->state;
+  if (state->currentState == GAME_STATE_PLAYING &&
+      state->score > previousScore) {
+    SDL_Log("吃到食物！当前得分: %d", state->score);
+  }
+  if (state->currentState == previousState) {
+    return;
+  }
+
+  switch (state->currentState) {
+  case GAME_STATE_MENU:
+    SDL_Log("游戏重置");
+    SDL_Log("按空格键开始游戏");
+    break;
+  case GAME_STATE_PLAYING:
+    SDL_Log(previousState == GAME_STATE_PAUSED ? "游戏继续" : "游戏开始！");
+    break;
+  case GAME_STATE_PAUSED:
+    SDL_Log("游戏暂停");
+    break;
+  case GAME_STATE_GAME_OVER:
+    SDL_Log("游戏结束！最终得分: %d", state->score);
+    break;
+  }
+}
+
+static int simulation_thread(void *data) {
+  Simulation *sim = (Simulation *)data;
+  const float stepSeconds = SIM_STEP_NS / 1000000000.0f;
+
+  Uint64 deadline = SDL_GetTicksNS();
+  Uint64 tickTimeNS = deadline;
+  while (SDL_GetAtomicInt(&sim->running)) {
+    bool changed = drain_input(sim);
+
+    GameState previousState = sim->game.state.currentState;
+    unsigned int previousTicks = sim->game.state.tickCount;
+    int previousScore = sim->game.state.score;
+    update_game(&sim->game, stepSeconds);
+    log_game_events(previousState, previousScore, &sim->game);
+
+    // 只有发生逻辑步进、状态变化或处理了输入时才发布新快照
+    if (sim->game.state.tickCount != previousTicks) {
+      record_tick_cells(sim, true);
+      tickTimeNS = deadline;
+      changed = true;
+    } else if (sim->game.state.currentState != previousState) {
+      // 回到菜单时棋盘已重建，不应从旧位置插值
+      if (sim->game.state.currentState == GAME_STATE_MENU) {
+        record_tick_cells(sim, false);
+      }
+      changed = true;
+    }
+    if (changed) {
+      publish_snapshot(sim, tickTimeNS);
+    }
+
+    // 按绝对截止时间调度，睡眠误差不会累积到逻辑时间中
+    deadline += SIM_STEP_NS;
+    Uint64 now = SDL_GetTicksNS();
+    if (deadline > now) {
+      SDL_DelayPrecise(deadline - now);
+    } else if (now - deadline > SIM_MAX_LAG_NS) {
+      deadline = now;
+    }
+  }
+  return 0;
+}
+
+bool start_simulation(Simulation *sim, const GameConfig *config) {
+  init_game(&sim->game, config);
+  SDL_Log("按空格键开始游戏");
+
+  const int cellCapacity = config->gridWidth * config->gridHeight;
+  for (int i = 0; i < 3; i++) {
+    init_game_snapshot(&sim->snapshots[i], config);
+  }
+  for (int i = 0; i < 2; i++) {
+    sim->tickCells[i] = NEW_ARRAY_ZEROED(GridCell, cellCapacity);
+  }
+  record_tick_cells(sim, false);
+  sim->writeIndex = 0;
+  sim->readIndex = 2;
+  SDL_SetAtomicInt(&sim->middle, 1);
+  SDL_SetAtomicInt(&sim->input.head, 0);
+  SDL_SetAtomicInt(&sim->input.tail, 0);
+
+  // 线程启动前先发布初始快照，保证渲染线程第一帧就有数据
+  publish_snapshot(sim, SDL_GetTicksNS());
+
+  SDL_SetAtomicInt(&sim->running, 1);
+  sim->thread = SDL_CreateThread(simulation_thread, "simulation", sim);
+  if (!sim->thread) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "创建模拟线程失败: %s",
+                 SDL_GetError());
+    SDL_SetAtomicInt(&sim->running, 0);
+    return false;
+  }
+  return true;
+}
+
+void stop_simulation(Simulation *sim) {
+  SDL_SetAtomicInt(&sim->running, 0);
+  if (sim->thread) {
+    SDL_WaitThread(sim->thread, NULL);
+    sim->thread = NULL;
+  }
+
+  cleanup_game(&sim->game);
+  for (int i = 0; i < 3; i++) {
+    cleanup_game_snapshot(&sim->snapshots[i]);
+  }
+  for (int i = 0; i < 2; i++) {
+    FREE(sim->tickCells[i]);
+  }
+}
+
+bool push_sim_input(Simulation *sim, SimInput input) {
+  SimInputQueue *queue = &sim->input;
+  unsigned int head = (unsigned int)SDL_GetAtomicInt(&queue->head);
+  unsigned int tail = (unsigned int)SDL_GetAtomicInt(&queue->tail);
+  if (head - tail >= SIM_INPUT_QUEUE_SIZE) {
+    return false;
+  }
+
+  queue->items[head & (SIM_INPUT_QUEUE_SIZE - 1)] = input;
+  SDL_MemoryBarrierRelease();
+  SDL_SetAtomicInt(&queue->head, (int)(head + 1));
+  return true;
+}
+
+const GameSnapshot *acquire_snapshot(Simulation *sim) {
+  // 中间缓冲有新数据时与读取缓冲交换，否则继续使用当前读取缓冲
+  if (SDL_GetAtomicInt(&sim->middle) & SNAPSHOT_FRESH) {
+    int previous = SDL_SetAtomicInt(&sim->middle, sim->readIndex);
+    sim->readIndex = previous & SNAPSHOT_INDEX_MASK;
+  }
+  return &sim->snapshots[sim->readIndex];
+}
+
+void init_game_snapshot(GameSnapshot *snapshot, const GameConfig *config) {
+  const int cellCapacity = config->gridWidth * config->gridHeight;
+  snapshot->snakeCells = NEW_ARRAY_ZEROED(GridCell, cellCapacity);
+  snapshot->previousCells = NEW_ARRAY_ZEROED(GridCell, cellCapacity);
+  snapshot->foodCells = NEW_ARRAY_ZEROED(GridCell, config->maxFoodCount);
+}
+
+void cleanup_game_snapshot(GameSnapshot *snapshot) {
+  FREE(snapshot->snakeCells);
+  FREE(snapshot->previousCells);
+  FREE(snapshot->foodCells);
+}
+
+void fill_game_snapshot(GameSnapshot *snapshot, const Game *game) {
+  const GameConfig *config = &game->state.config;
+
+  snapshot->snakeLength = copy_snake_cells(snapshot->snakeCells, game);
+  snapshot->previousLength = 0;
+
+  int count = 0;
+  const KNode *node;
+  knode_for_each(node, &game->foodManager.head) {
+    if (count >= config->maxFoodCount) {
+      break;
+    }
+    const Food *food = container_of(node, Food, node);
+    snapshot->foodCells[count].x = food->x;
+    snapshot->foodCells[count].y = food->y;
+    count++;
+  }
+  snapshot->foodCount = count;
+
+  snapshot->score = game->state.score;
+  snapshot->state = game->state.currentState;
+  snapshot->tickCount = game->state.tickCount;
+  snapshot->tickTimeNS = 0;
+  snapshot->moveInterval = config->moveInterval;
+}
+
+void interpolate_snake_cell(const GameSnapshot *snapshot, int index,
+                            float alpha, float *x, float *y) {
+  const GridCell *current = &snapshot->snakeCells[index];
+  if (snapshot->previousLength == 0) {
+    *x = (float)current->x;
+    *y = (float)current->y;
+    return;
+  }
+
+  // 每一节都移动到前一节原来的位置，因此第index节对应上一步的第index节；
+  // 增长时新出现的尾节在上一步中不存在，停留在原尾部位置
+  int previousIndex = index < snapshot->previousLength
+                          ? index
+                          : snapshot->previousLength - 1;
+  const GridCell *previous = &snapshot->previousCells[previousIndex];
+  *x = previous->x + (current->x - previous->x) * alpha;
+  *y = previous->y + (current->y - previous->y) * alpha;
+}
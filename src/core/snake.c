@@ -1,5 +1,6 @@
 #include "core/snake.h"
 #include "core/state.h"
+#include "core/zobrist.h"
 #include "utils/memory.h"
 #include <SDL3/SDL.h>
 #include <stdlib.h>
@@ -13,6 +14,7 @@ void init_snake(Snake* snake, int startX, int startY, int initialLength) {
     knode_init(&snake->head);
     snake->length = 0;
     snake->isAlive = true;
+    snake->hash = 0;
     
     // 创建初始蛇身
     for (int i = 0; i < initialLength; i++) {
@@ -36,6 +38,12 @@ void init_snake(Snake* snake, int startX, int startY, int initialLength) {
         // 使用knode_add_tail而不是knode_add
         knode_add_tail(&segment->node, &snake->head);
         snake->length++;
+        if (i == 0) {
+            snake->hash ^= zobrist_cell_key(segment->x, segment->y, ZOBRIST_HEAD);
+        } else {
+            // 蛇身向左延伸，每一节都指向右边的前一节
+            snake->hash ^= zobrist_body_key(segment->x, segment->y, segment->x + 1, segment->y);
+        }
     }
 }
 
@@ -54,6 +62,7 @@ void cleanup_snake(Snake* snake) {
     
     snake->length = 0;
     snake->isAlive = false;
+    snake->hash = 0;
 }
 
 bool move_snake(Snake* snake, int direction, int gridWidth, int gridHeight, bool shouldGrow) {
@@ -98,12 +107,43 @@ bool move_snake(Snake* snake, int direction, int gridWidth, int gridHeight, bool
         return false;
     }
     
-    // 移动蛇：添加新蛇头
-    SnakeSegment* newHead = (SnakeSegment*)MALLOC(sizeof(SnakeSegment));
-    if (newHead == NULL) {
-        return false;
+    advance_snake(snake, newHeadX, newHeadY, shouldGrow);
+    return true;
+}
+
+void advance_snake(Snake* snake, int newHeadX, int newHeadY, bool shouldGrow) {
+    int headX, headY;
+    get_snake_head(snake, &headX, &headY);
+    
+    // 移动蛇：不增长时直接把蛇尾节点摘下作为新蛇头，避免每步分配和释放
+    SnakeSegment* newHead;
+    if (!shouldGrow) {
+        KNode* tail = snake->head.prev;
+        newHead = container_of(tail, SnakeSegment, node);
+        // 蛇尾指向前一节；只有一节时前一节就是新蛇头
+        int nextX = newHeadX;
+        int nextY = newHeadY;
+        if (!knode_is_head(tail->prev, &snake->head)) {
+            SnakeSegment* next = container_of(tail->prev, SnakeSegment, node);
+            nextX = next->x;
+            nextY = next->y;
+        }
+        snake->hash ^= zobrist_body_key(newHead->x, newHead->y, nextX, nextY);
+        knode_del(tail);
+    } else {
+        newHead = (SnakeSegment*)MALLOC(sizeof(SnakeSegment));
+        if (newHead == NULL) {
+            return;
+        }
+        // 增长时，蛇的长度增加
+        snake->length++;
     }
     
+    // 旧蛇头成为指向新蛇头的一节
+    snake->hash ^= zobrist_cell_key(headX, headY, ZOBRIST_HEAD) ^
+                   zobrist_body_key(headX, headY, newHeadX, newHeadY) ^
+                   zobrist_cell_key(newHeadX, newHeadY, ZOBRIST_HEAD);
+    
     // 手动初始化节点，避免宏中的return语句
     newHead->node.next = &newHead->node;
     newHead->node.prev = &newHead->node;
@@ -112,19 +152,6 @@ bool move_snake(Snake* snake, int direction, int gridWidth, int gridHeight, bool
     
     // 添加到链表头部
     knode_add(&newHead->node, &snake->head);
-    
-    // 如果不增长，移除蛇尾；如果增长，保持蛇尾（长度增加）
-    if (!shouldGrow) {
-        KNode* tail = snake->head.prev;
-        SnakeSegment* tailSegment = container_of(tail, SnakeSegment, node);
-        knode_del(tail);
-        FREE(tailSegment);
-    } else {
-        // 增长时，蛇的长度增加
-        snake->length++;
-    }
-    
-    return true;
 }
 
 
@@ -0,0 +1,170 @@
+#include "core/sparse_grid.h"
+#include "utils/memory.h"
+
+// 散列表的最小容量
+#define SPARSE_MIN_SLOTS 16
+
+static int slot_capacity_for(int chunks) {
+  // 装载率不超过1/2，探测序列保持很短
+  int capacity = SPARSE_MIN_SLOTS;
+  while (capacity < chunks * 2) {
+    capacity *= 2;
+  }
+  return capacity;
+}
+
+// 单线程插入，只在重建散列表时使用
+static void place_chunk(SparseGrid *grid, uint64_t key, SparseChunk *chunk) {
+  const uint32_t mask = (uint32_t)(grid->slotCapacity - 1);
+  uint32_t slot = sparse_slot_of(grid, key);
+  while (grid->slots[slot].key != 0) {
+    slot = (slot + 1) & mask;
+  }
+  grid->slots[slot].key = key;
+  grid->slots[slot].chunk = chunk;
+  grid->keyCount++;
+}
+
+// 按新容量重建散列表，丢弃分块已释放的条目
+static void rebuild_slots(SparseGrid *grid, int capacity) {
+  SparseSlot *old = grid->slots;
+  const int oldCapacity = grid->slotCapacity;
+  grid->slots = NEW_ARRAY_ZEROED(SparseSlot, capacity);
+  grid->slotCapacity = capacity;
+  grid->keyCount = 0;
+  for (int i = 0; i < oldCapacity; i++) {
+    if (old[i].chunk != NULL) {
+      place_chunk(grid, old[i].key, old[i].chunk);
+    }
+  }
+  FREE(old);
+}
+
+void init_sparse_grid(SparseGrid *grid, int width, int height,
+                      GridLayoutKind layout) {
+  memset(grid, 0, sizeof(*grid));
+  grid->width = width;
+  grid->height = height;
+  // 分块是2的幂的正方形，各种排列的下标都正好占满SPARSE_CHUNK_SIZE²
+  init_grid_layout(&grid->chunkLayout, layout, SPARSE_CHUNK_SIZE,
+                   SPARSE_CHUNK_SIZE);
+  grid->slotCapacity = SPARSE_MIN_SLOTS;
+  grid->slots = NEW_ARRAY_ZEROED(SparseSlot, grid->slotCapacity);
+}
+
+void cleanup_sparse_grid(SparseGrid *grid) {
+  for (int i = 0; i < grid->slotCapacity && grid->slots != NULL; i++) {
+    FREE(grid->slots[i].chunk);
+  }
+  FREE(grid->slots);
+  grid->slotCapacity = 0;
+  grid->keyCount = 0;
+  grid->chunkCount = 0;
+  grid->emptyChunks = 0;
+}
+
+void reserve_sparse_chunks(SparseGrid *grid, int count) {
+  // 释放过的分块仍占着条目，容量不够时先丢弃它们，再按需扩大
+  if (slot_capacity_for(grid->keyCount + count) > grid->slotCapacity) {
+    rebuild_slots(grid, slot_capacity_for(grid->chunkCount + count));
+  }
+}
+
+/**
+ * 找到或创建(x, y)所在的分块，可在多个线程中同时调用：
+ * 先用CAS占据条目的键，再用CAS发布分块，输掉竞争的一方释放自己的分块
+ */
+static SparseChunk *insert_chunk(SparseGrid *grid, int x, int y) {
+  const uint64_t key = sparse_chunk_key(x, y);
+  const uint32_t mask = (uint32_t)(grid->slotCapacity - 1);
+  uint32_t slot = sparse_slot_of(grid, key);
+  while (true) {
+    SparseSlot *entry = &grid->slots[slot];
+    uint64_t found = __atomic_load_n(&entry->key, __ATOMIC_ACQUIRE);
+    if (found == 0 &&
+        __atomic_compare_exchange_n(&entry->key, &found, key, false,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+      __atomic_fetch_add(&grid->keyCount, 1, __ATOMIC_RELAXED);
+      break;
+    }
+    if (found == key) {
+      break;
+    }
+    slot = (slot + 1) & mask;
+  }
+
+  SparseChunk *chunk =
+      __atomic_load_n(&grid->slots[slot].chunk, __ATOMIC_ACQUIRE);
+  if (chunk != NULL) {
+    return chunk;
+  }
+  SparseChunk *created = NEW_ZEROED(SparseChunk);
+  if (!__atomic_compare_exchange_n(&grid->slots[slot].chunk, &chunk, created,
+                                   false, __ATOMIC_ACQ_REL,
+                                   __ATOMIC_ACQUIRE)) {
+    FREE(created);
+    return chunk;
+  }
+  __atomic_fetch_add(&grid->chunkCount, 1, __ATOMIC_RELAXED);
+  __atomic_fetch_add(&grid->emptyChunks, 1, __ATOMIC_RELAXED);
+  return created;
+}
+
+void set_sparse_cell(SparseGrid *grid, int x, int y, uint32_t value) {
+  SparseChunk *chunk = find_sparse_chunk(grid, x, y);
+  if (chunk == NULL) {
+    if (value == 0) {
+      return;
+    }
+    chunk = insert_chunk(grid, x, y);
+  }
+
+  uint32_t *cell = &chunk->cells[sparse_cell_offset(grid, x, y)];
+  const bool wasOccupied = *cell != 0;
+  *cell = value;
+  if (wasOccupied == (value != 0)) {
+    return;
+  }
+
+  // 同一分块的其他格子可能正由其他线程写入，计数用原子操作
+  if (value != 0) {
+    if (__atomic_fetch_add(&chunk->occupied, 1, __ATOMIC_RELAXED) == 0) {
+      __atomic_fetch_sub(&grid->emptyChunks, 1, __ATOMIC_RELAXED);
+    }
+  } else {
+    if (__atomic_fetch_sub(&chunk->occupied, 1, __ATOMIC_RELAXED) == 1) {
+      __atomic_fetch_add(&grid->emptyChunks, 1, __ATOMIC_RELAXED);
+    }
+  }
+}
+
+int compact_sparse_grid(SparseGrid *grid) {
+  // 空分块不多时留着，避免每步都扫描散列表；再次写入时直接复用
+  if (grid->emptyChunks == 0 || grid->emptyChunks * 8 < grid->chunkCount) {
+    return 0;
+  }
+
+  // 开放寻址不能直接删除条目，只释放分块，条目留到reserve_sparse_chunks重建
+  int freed = 0;
+  for (int i = 0; i < grid->slotCapacity; i++) {
+    SparseChunk *chunk = grid->slots[i].chunk;
+    if (chunk != NULL && chunk->occupied == 0) {
+      FREE(grid->slots[i].chunk);
+      freed++;
+    }
+  }
+  grid->chunkCount -= freed;
+  grid->emptyChunks = 0;
+  return freed;
+}
+
+int get_sparse_chunk_occupancy(const SparseGrid *grid, int x, int y) {
+  const SparseChunk *chunk = find_sparse_chunk(grid, x, y);
+  return chunk != NULL ? __atomic_load_n(&chunk->occupied, __ATOMIC_RELAXED)
+                       : 0;
+}
+
+size_t sparse_grid_bytes(const SparseGrid *grid) {
+  return sizeof(SparseChunk) * (size_t)grid->chunkCount +
+         sizeof(SparseSlot) * (size_t)grid->slotCapacity;
+}
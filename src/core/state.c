@@ -13,6 +13,7 @@ void init_game_state(GameStateData* state, const GameConfig* config) {
     state->directionChanged = false;
     state->currentDirection = DIRECTION_RIGHT;
     state->nextDirection = DIRECTION_RIGHT;
+    state->tickCount = 0;
 }
 
 bool update_game_state(GameStateData* state, float deltaTime) {
@@ -27,6 +28,7 @@ bool update_game_state(GameStateData* state, float deltaTime) {
     if (state->timeSinceLastMove >= state->config.moveInterval) {
         // 重置时间计数器
         state->timeSinceLastMove = 0.0f;
+        state->tickCount++;
         
         // 应用方向改变
         if (state->directionChanged) {
@@ -69,8 +71,6 @@ void start_game(GameStateData* state) {
     state->currentDirection = DIRECTION_RIGHT;
     state->nextDirection = DIRECTION_RIGHT;
     state->directionChanged = false;
-    
-    SDL_Log("游戏开始！");
 }
 
 void pause_game(GameStateData* state) {
@@ -79,7 +79,6 @@ void pause_game(GameStateData* state) {
     }
     
     state->currentState = GAME_STATE_PAUSED;
-    SDL_Log("游戏暂停");
 }
 
 void resume_game(GameStateData* state) {
@@ -88,7 +87,6 @@ void resume_game(GameStateData* state) {
     }
     
     state->currentState = GAME_STATE_PLAYING;
-    SDL_Log("游戏继续");
 }
 
 void game_over(GameStateData* state) {
@@ -97,7 +95,6 @@ void game_over(GameStateData* state) {
     }
     
     state->currentState = GAME_STATE_GAME_OVER;
-    SDL_Log("游戏结束！最终得分: %d", state->score);
 }
 
 void reset_game(GameStateData* state) {
@@ -111,6 +108,4 @@ void reset_game(GameStateData* state) {
     state->currentDirection = DIRECTION_RIGHT;
     state->nextDirection = DIRECTION_RIGHT;
     state->directionChanged = false;
-    
-    SDL_Log("游戏重置");
 }
\ No newline at end of file
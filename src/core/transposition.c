@@ -0,0 +1,170 @@
+#include "core/transposition.h"
+#include "utils/memory.h"
+
+#define TRANSPOSITION_BUCKET_BYTES                                             \
+  (sizeof(TranspositionSlot) * TRANSPOSITION_BUCKET_SIZE)
+
+// 代数0表示空条目（保证有效条目的data不为0），1是回绕时旧条目统一改写成的
+// 代数，当前代数只在2..255之间循环，旧条目因此不会在回绕后又被当成当前代
+#define GENERATION_STALE 1
+#define GENERATION_FIRST 2
+
+static inline uint64_t pack_data(const TranspositionData *data) {
+  return (uint64_t)(uint32_t)data->value |
+         ((uint64_t)data->depth << 32) | ((uint64_t)data->move << 48) |
+         ((uint64_t)data->generation << 56);
+}
+
+static inline TranspositionData unpack_data(uint64_t packed) {
+  TranspositionData data;
+  data.value = (int32_t)(uint32_t)packed;
+  data.depth = (uint16_t)(packed >> 32);
+  data.move = (uint8_t)(packed >> 48);
+  data.generation = (uint8_t)(packed >> 56);
+  return data;
+}
+
+static inline TranspositionSlot *
+bucket_of(const TranspositionTable *table, uint64_t key) {
+  return &table->slots[(key & table->bucketMask) * TRANSPOSITION_BUCKET_SIZE];
+}
+
+// 两个字各自原子读取；是否属于同一次写入由调用方用异或校验
+static inline void load_slot(const TranspositionSlot *slot, uint64_t *check,
+                             uint64_t *data) {
+  *check = __atomic_load_n(&slot->check, __ATOMIC_RELAXED);
+  *data = __atomic_load_n(&slot->data, __ATOMIC_RELAXED);
+}
+
+void init_transposition_table(TranspositionTable *table, size_t megabytes) {
+  const size_t bytes = megabytes * 1024 * 1024;
+  uint64_t buckets = 1;
+  while (buckets * 2 * TRANSPOSITION_BUCKET_BYTES <= bytes) {
+    buckets *= 2;
+  }
+
+  // 多分配一个桶用于按缓存行对齐
+  table->memory = MALLOC((buckets + 1) * TRANSPOSITION_BUCKET_BYTES);
+  uintptr_t address = (uintptr_t)table->memory;
+  address = (address + TRANSPOSITION_BUCKET_BYTES - 1) &
+            ~(uintptr_t)(TRANSPOSITION_BUCKET_BYTES - 1);
+  table->slots = (TranspositionSlot *)address;
+  table->bucketMask = buckets - 1;
+  table->generation = GENERATION_FIRST;
+  clear_transposition_table(table);
+}
+
+void cleanup_transposition_table(TranspositionTable *table) {
+  FREE(table->memory);
+  table->slots = NULL;
+}
+
+void clear_transposition_table(TranspositionTable *table) {
+  memset(table->slots, 0, (table->bucketMask + 1) * TRANSPOSITION_BUCKET_BYTES);
+}
+
+// 把所有非空条目的代数改写为GENERATION_STALE，键不变
+static void mark_entries_stale(TranspositionTable *table) {
+  const uint64_t slotCount =
+      (table->bucketMask + 1) * TRANSPOSITION_BUCKET_SIZE;
+  for (uint64_t i = 0; i < slotCount; i++) {
+    TranspositionSlot *slot = &table->slots[i];
+    if (slot->data == 0) {
+      continue;
+    }
+    const uint64_t key = slot->check ^ slot->data;
+    TranspositionData data = unpack_data(slot->data);
+    data.generation = GENERATION_STALE;
+    slot->data = pack_data(&data);
+    slot->check = key ^ slot->data;
+  }
+}
+
+void new_transposition_generation(TranspositionTable *table) {
+  // 回绕时旧条目的代数会与新的当前代数重复，先把它们全部标为旧代
+  if (table->generation == UINT8_MAX) {
+    mark_entries_stale(table);
+    table->generation = GENERATION_FIRST;
+  } else {
+    table->generation++;
+  }
+}
+
+bool probe_transposition(const TranspositionTable *table, uint64_t key,
+                         TranspositionData *data, TranspositionStats *stats) {
+  const TranspositionSlot *bucket = bucket_of(table, key);
+  bool occupied = true;
+  for (int i = 0; i < TRANSPOSITION_BUCKET_SIZE; i++) {
+    uint64_t check, packed;
+    load_slot(&bucket[i], &check, &packed);
+    if (packed != 0 && (check ^ packed) == key) {
+      *data = unpack_data(packed);
+      if (stats != NULL) {
+        stats->probes++;
+        stats->hits++;
+      }
+      return true;
+    }
+    occupied = occupied && packed != 0;
+  }
+
+  if (stats != NULL) {
+    stats->probes++;
+    stats->collisions += occupied;
+  }
+  return false;
+}
+
+void store_transposition(TranspositionTable *table, uint64_t key,
+                         const TranspositionData *data,
+                         TranspositionStats *stats) {
+  TranspositionSlot *bucket = bucket_of(table, key);
+
+  // 同一局面的条目直接覆盖；否则选空条目，其次是旧代条目，同代中可信度最低者
+  int victim = 0;
+  int victimPriority = INT32_MAX;
+  bool sameKey = false;
+  for (int i = 0; i < TRANSPOSITION_BUCKET_SIZE; i++) {
+    uint64_t check, packed;
+    load_slot(&bucket[i], &check, &packed);
+    if (packed != 0 && (check ^ packed) == key) {
+      victim = i;
+      sameKey = true;
+      break;
+    }
+
+    int priority = -1;
+    if (packed != 0) {
+      TranspositionData old = unpack_data(packed);
+      priority = old.depth + (old.generation == table->generation ? 65536 : 0);
+    }
+    if (priority < victimPriority) {
+      victim = i;
+      victimPriority = priority;
+    }
+  }
+
+  TranspositionData stored = *data;
+  stored.generation = table->generation;
+  const uint64_t packed = pack_data(&stored);
+  __atomic_store_n(&bucket[victim].check, key ^ packed, __ATOMIC_RELAXED);
+  __atomic_store_n(&bucket[victim].data, packed, __ATOMIC_RELAXED);
+
+  if (stats != NULL) {
+    stats->stores++;
+    stats->overwrites += !sameKey && victimPriority >= 0;
+  }
+}
+
+void merge_transposition_stats(TranspositionStats *total,
+                               const TranspositionStats *stats) {
+  total->probes += stats->probes;
+  total->hits += stats->hits;
+  total->collisions += stats->collisions;
+  total->stores += stats->stores;
+  total->overwrites += stats->overwrites;
+}
+
+double transposition_hit_rate(const TranspositionStats *stats) {
+  return stats->probes > 0 ? (double)stats->hits / (double)stats->probes : 0.0;
+}
@@ -0,0 +1,285 @@
+#include "env/env_server.h"
+#include "utils/memory.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <limits.h>
+#include <sched.h>
+#include <stddef.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#endif
+
+// 数组起始位置对齐到缓存行
+#define ENV_SHM_ALIGN 64
+// 进入内核等待前的自旋次数，批量步进通常在此期间完成
+#define ENV_SPIN_COUNT 4000
+// 单次等待的超时（纳秒），超时后重新检查停止标志
+#define ENV_WAIT_TIMEOUT_NS 100000000L
+
+#if defined(__x86_64__) || defined(__i386__)
+#define cpu_relax() __builtin_ia32_pause()
+#elif defined(__aarch64__)
+#define cpu_relax() __asm__ __volatile__("yield")
+#else
+#define cpu_relax() ((void)0)
+#endif
+
+_Static_assert(offsetof(EnvShmHeader, requestSeq) % ENV_SHM_ALIGN == 0,
+               "requestSeq必须独占缓存行");
+_Static_assert(offsetof(EnvShmHeader, responseSeq) % ENV_SHM_ALIGN == 0,
+               "responseSeq必须独占缓存行");
+
+struct EnvClient {
+  EnvShmHeader *header; // 映射的共享内存
+  size_t size;          // 映射大小
+};
+
+static size_t align_up(size_t value) {
+  return (value + ENV_SHM_ALIGN - 1) & ~(size_t)(ENV_SHM_ALIGN - 1);
+}
+
+static uint32_t load_acquire(const uint32_t *word) {
+  return __atomic_load_n(word, __ATOMIC_ACQUIRE);
+}
+
+static void store_release(uint32_t *word, uint32_t value) {
+  __atomic_store_n(word, value, __ATOMIC_RELEASE);
+}
+
+// 等待门铃值不再等于expected；可能提前返回，由调用者重新检查
+static void doorbell_wait(uint32_t *word, uint32_t expected) {
+  for (int i = 0; i < ENV_SPIN_COUNT; i++) {
+    if (load_acquire(word) != expected) {
+      return;
+    }
+    cpu_relax();
+  }
+#ifdef __linux__
+  // 共享内存跨进程，不能使用FUTEX_PRIVATE_FLAG
+  struct timespec timeout = {0, ENV_WAIT_TIMEOUT_NS};
+  syscall(SYS_futex, word, FUTEX_WAIT, expected, &timeout, NULL, 0);
+#else
+  sched_yield();
+#endif
+}
+
+static void doorbell_ring(uint32_t *word) {
+#ifdef __linux__
+  syscall(SYS_futex, word, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#else
+  (void)word;
+#endif
+}
+
+static void *shm_at(EnvShmHeader *header, uint64_t offset) {
+  return (unsigned char *)header + offset;
+}
+
+static void observe_all(SnakeEnv **envs, EnvShmHeader *header) {
+  uint8_t *observations = shm_at(header, header->observationsOffset);
+  for (uint32_t i = 0; i < header->envCount; i++) {
+    snake_env_observe(envs[i], observations + (size_t)i * header->observationSize);
+  }
+}
+
+// 创建共享内存；同名的残留对象（例如服务异常退出）会被替换
+static EnvShmHeader *create_region(const char *name, size_t size) {
+  int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) {
+    shm_unlink(name);
+    fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+  }
+  if (fd < 0) {
+    return NULL;
+  }
+
+  void *memory = MAP_FAILED;
+  if (ftruncate(fd, (off_t)size) == 0) {
+    memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+  if (memory == MAP_FAILED) {
+    shm_unlink(name);
+    return NULL;
+  }
+  return (EnvShmHeader *)memory;
+}
+
+static void serve(SnakeEnv **envs, EnvShmHeader *header,
+                  const volatile int *stop) {
+  SnakeEnvStep *results = shm_at(header, header->resultsOffset);
+  const int32_t *actions = shm_at(header, header->actionsOffset);
+  uint32_t served = load_acquire(&header->requestSeq);
+
+  while (stop == NULL || !*stop) {
+    uint32_t request = load_acquire(&header->requestSeq);
+    if (request == served) {
+      doorbell_wait(&header->requestSeq, served);
+      continue;
+    }
+
+    uint32_t command = header->command;
+    switch (command) {
+    case ENV_COMMAND_STEP:
+      snake_env_step_many(envs, (int32_t)header->envCount, actions, results);
+      observe_all(envs, header);
+      break;
+    case ENV_COMMAND_RESET:
+      for (uint32_t i = 0; i < header->envCount; i++) {
+        snake_env_reset(envs[i]);
+      }
+      memset(results, 0, sizeof(SnakeEnvStep) * header->envCount);
+      observe_all(envs, header);
+      break;
+    default:
+      break;
+    }
+
+    served = request;
+    store_release(&header->responseSeq, served);
+    doorbell_ring(&header->responseSeq);
+    if (command == ENV_COMMAND_SHUTDOWN) {
+      break;
+    }
+  }
+}
+
+int env_server_run(const char *name, const SnakeEnvConfig *config,
+                   uint32_t envCount, uint64_t seed,
+                   const volatile int *stop) {
+  if (name == NULL || config == NULL || envCount == 0) {
+    return -1;
+  }
+
+  SnakeEnv **envs = NEW_ARRAY_ZEROED(SnakeEnv *, envCount);
+  int status = -1;
+  for (uint32_t i = 0; i < envCount; i++) {
+    envs[i] = snake_env_create(config, seed + i);
+    if (envs[i] == NULL) {
+      goto cleanup_envs;
+    }
+  }
+
+  size_t observationSize = snake_env_observation_size(envs[0]);
+  size_t actionsOffset = align_up(sizeof(EnvShmHeader));
+  size_t resultsOffset = align_up(actionsOffset + sizeof(int32_t) * envCount);
+  size_t observationsOffset =
+      align_up(resultsOffset + sizeof(SnakeEnvStep) * envCount);
+  size_t totalSize = align_up(observationsOffset + observationSize * envCount);
+
+  EnvShmHeader *header = create_region(name, totalSize);
+  if (header == NULL) {
+    goto cleanup_envs;
+  }
+
+  // ftruncate后内容已清零，只需填写非零字段；magic最后发布
+  header->version = ENV_SHM_VERSION;
+  header->envCount = envCount;
+  header->observationSize = (uint32_t)observationSize;
+  header->actionsOffset = actionsOffset;
+  header->resultsOffset = resultsOffset;
+  header->observationsOffset = observationsOffset;
+  header->totalSize = totalSize;
+  header->config = *config;
+  observe_all(envs, header);
+  store_release(&header->magic, ENV_SHM_MAGIC);
+
+  serve(envs, header, stop);
+
+  // 唤醒可能仍在等待的客户端，让它看到服务已停止
+  store_release(&header->magic, 0);
+  doorbell_ring(&header->responseSeq);
+  munmap(header, totalSize);
+  shm_unlink(name);
+  status = 0;
+
+cleanup_envs:
+  for (uint32_t i = 0; i < envCount; i++) {
+    snake_env_destroy(envs[i]);
+  }
+  FREE(envs);
+  return status;
+}
+
+EnvClient *env_client_open(const char *name) {
+  int fd = shm_open(name, O_RDWR, 0);
+  if (fd < 0) {
+    return NULL;
+  }
+
+  struct stat info;
+  void *memory = MAP_FAILED;
+  if (fstat(fd, &info) == 0 && (size_t)info.st_size >= sizeof(EnvShmHeader)) {
+    memory = mmap(NULL, (size_t)info.st_size, PROT_READ | PROT_WRITE,
+                  MAP_SHARED, fd, 0);
+  }
+  close(fd);
+  if (memory == MAP_FAILED) {
+    return NULL;
+  }
+
+  EnvShmHeader *header = (EnvShmHeader *)memory;
+  if (load_acquire(&header->magic) != ENV_SHM_MAGIC ||
+      header->version != ENV_SHM_VERSION ||
+      header->totalSize > (uint64_t)info.st_size) {
+    munmap(memory, (size_t)info.st_size);
+    return NULL;
+  }
+
+  EnvClient *client = NEW(EnvClient);
+  client->header = header;
+  client->size = (size_t)info.st_size;
+  return client;
+}
+
+void env_client_close(EnvClient *client) {
+  if (client == NULL) {
+    return;
+  }
+
+  munmap(client->header, client->size);
+  FREE(client);
+}
+
+const EnvShmHeader *env_client_header(const EnvClient *client) {
+  return client->header;
+}
+
+int32_t *env_client_actions(EnvClient *client) {
+  return shm_at(client->header, client->header->actionsOffset);
+}
+
+const SnakeEnvStep *env_client_results(const EnvClient *client) {
+  return shm_at(client->header, client->header->resultsOffset);
+}
+
+const uint8_t *env_client_observations(const EnvClient *client) {
+  return shm_at(client->header, client->header->observationsOffset);
+}
+
+int env_client_request(EnvClient *client, EnvCommand command) {
+  EnvShmHeader *header = client->header;
+
+  // 只有一个客户端写requestSeq，递增无需原子读改写
+  header->command = (uint32_t)command;
+  uint32_t request = header->requestSeq + 1;
+  store_release(&header->requestSeq, request);
+  doorbell_ring(&header->requestSeq);
+
+  uint32_t response;
+  while ((response = load_acquire(&header->responseSeq)) != request) {
+    if (load_acquire(&header->magic) != ENV_SHM_MAGIC) {
+      return -1;
+    }
+    doorbell_wait(&header->responseSeq, response);
+  }
+  return 0;
+}
+
+#endif
@@ -0,0 +1,51 @@
+#include "env/env_server.h"
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static volatile int stopRequested = 0;
+
+static void handle_signal(int signal) {
+  (void)signal;
+  stopRequested = 1;
+}
+
+int main(int argc, char **argv) {
+  if (argc < 3) {
+    fprintf(stderr,
+            "用法: %s <共享内存名称> <环境数量> [种子] [网格宽度] [网格高度]\n",
+            argv[0]);
+    return 1;
+  }
+
+  const char *name = argv[1];
+  long envCount = strtol(argv[2], NULL, 10);
+  uint64_t seed = argc > 3 ? strtoull(argv[3], NULL, 10) : 0;
+
+  SnakeEnvConfig config;
+  snake_env_default_config(&config);
+  if (argc > 4) {
+    config.gridWidth = (int32_t)strtol(argv[4], NULL, 10);
+  }
+  if (argc > 5) {
+    config.gridHeight = (int32_t)strtol(argv[5], NULL, 10);
+  }
+  if (envCount <= 0) {
+    fprintf(stderr, "环境数量必须大于0\n");
+    return 1;
+  }
+
+  struct sigaction action = {0};
+  action.sa_handler = handle_signal;
+  sigaction(SIGINT, &action, NULL);
+  sigaction(SIGTERM, &action, NULL);
+
+  printf("启动环境服务: %s，环境数量: %ld\n", name, envCount);
+  if (env_server_run(name, &config, (uint32_t)envCount, seed,
+                     &stopRequested) != 0) {
+    fprintf(stderr, "环境服务启动失败\n");
+    return 1;
+  }
+  printf("环境服务已停止\n");
+  return 0;
+}
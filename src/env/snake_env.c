@@ -0,0 +1,166 @@
+#include "env/snake_env.h"
+#include "core/game.h"
+#include "core/observation.h"
+#include "render/soft_renderer.h"
+#include "utils/memory.h"
+
+// 每一步把时间推进一个移动间隔，正好触发一次逻辑步进
+#define ENV_MOVE_INTERVAL 1.0f
+
+struct SnakeEnv {
+  Game game;             // 游戏，创建后始终处于游戏中状态
+  SnakeEnvConfig config; // 环境配置
+  uint32_t episodeSteps; // 本局已执行的步数
+  uint32_t episode;      // 已开始的局数减一
+};
+
+static bool is_valid_config(const SnakeEnvConfig *config) {
+  // 初始蛇身从中心向左延伸，必须完全落在棋盘内
+  return config->gridWidth >= 2 && config->gridHeight >= 1 &&
+         config->initialSnakeLength >= 1 &&
+         config->initialSnakeLength <= config->gridWidth / 2 + 1 &&
+         config->maxFoodCount >= 1 && config->maxEpisodeSteps >= 0;
+}
+
+// 重建棋盘并直接开始新的一局；状态机一直停留在游戏中状态
+static void begin_episode(SnakeEnv *env) {
+  reset_game_board(&env->game);
+  start_game(&env->game.state);
+  env->episodeSteps = 0;
+}
+
+uint32_t snake_env_version(void) { return SNAKE_ENV_VERSION; }
+
+void snake_env_default_config(SnakeEnvConfig *config) {
+  config->gridWidth = 20;
+  config->gridHeight = 20;
+  config->initialSnakeLength = 3;
+  config->maxFoodCount = 1;
+  config->maxEpisodeSteps = 0;
+  config->deathReward = -1.0f;
+}
+
+SnakeEnv *snake_env_create(const SnakeEnvConfig *config, uint64_t seed) {
+  if (config == NULL || !is_valid_config(config)) {
+    return NULL;
+  }
+
+  SnakeEnv *env = NEW_ZEROED(SnakeEnv);
+  env->config = *config;
+
+  GameConfig gameConfig = {
+      .gridWidth = config->gridWidth,
+      .gridHeight = config->gridHeight,
+      .gridSize = 1,
+      .initialSnakeLength = config->initialSnakeLength,
+      .maxFoodCount = config->maxFoodCount,
+      .moveInterval = ENV_MOVE_INTERVAL,
+  };
+  init_game(&env->game, &gameConfig);
+
+  // 从菜单进入游戏中状态，之后按种子重建棋盘，使第一局的食物也可复现
+  send_game_command(&env->game, GAME_COMMAND_ACTION);
+  update_game(&env->game, 0.0f);
+  seed_food_manager(&env->game.foodManager, seed);
+  begin_episode(env);
+  return env;
+}
+
+void snake_env_destroy(SnakeEnv *env) {
+  if (env == NULL) {
+    return;
+  }
+
+  cleanup_game(&env->game);
+  FREE(env);
+}
+
+void snake_env_reset(SnakeEnv *env) {
+  begin_episode(env);
+  env->episode++;
+}
+
+void snake_env_step(SnakeEnv *env, int32_t action, SnakeEnvStep *result) {
+  Game *game = &env->game;
+  if (action >= SNAKE_ENV_ACTION_UP && action <= SNAKE_ENV_ACTION_RIGHT) {
+    change_direction(&game->state, (Direction)action);
+  }
+
+  int previousScore = game->state.score;
+  update_game(game, ENV_MOVE_INTERVAL);
+  env->episodeSteps++;
+
+  bool dead = !game->snake.isAlive;
+  bool truncated = !dead && env->config.maxEpisodeSteps > 0 &&
+                   env->episodeSteps >= (uint32_t)env->config.maxEpisodeSteps;
+
+  result->reward = dead ? env->config.deathReward
+                        : (float)(game->state.score - previousScore);
+  result->done = dead || truncated;
+  result->truncated = truncated;
+  result->score = game->state.score;
+  result->length = game->snake.length;
+  result->episodeSteps = env->episodeSteps;
+  result->episode = env->episode;
+
+  // 本局结束时立即重置，调用者观测到的已是新一局的初始局面
+  if (result->done) {
+    snake_env_reset(env);
+  }
+}
+
+void snake_env_step_many(SnakeEnv *const *envs, int32_t count,
+                         const int32_t *actions, SnakeEnvStep *results) {
+  for (int32_t i = 0; i < count; i++) {
+    snake_env_step(envs[i], actions[i], &results[i]);
+  }
+}
+
+size_t snake_env_observation_size(const SnakeEnv *env) {
+  return observation_tensor_size(&env->game.state.config);
+}
+
+void snake_env_observe(const SnakeEnv *env, uint8_t *observation) {
+  encode_observation_tensor(&env->game, observation);
+}
+
+uint64_t snake_env_hash(const SnakeEnv *env) { return game_hash(&env->game); }
+
+size_t snake_env_render_size(const SnakeEnv *env, int32_t scale,
+                             int32_t format, int32_t *width,
+                             int32_t *height) {
+  if (scale < 1 ||
+      (format != SNAKE_ENV_FORMAT_RGB && format != SNAKE_ENV_FORMAT_GRAY)) {
+    return 0;
+  }
+
+  int w, h;
+  soft_target_size(&env->game.state.config, scale, &w, &h);
+  if (width != NULL) {
+    *width = w;
+  }
+  if (height != NULL) {
+    *height = h;
+  }
+  return (size_t)w * h * (format == SNAKE_ENV_FORMAT_RGB ? 3 : 1);
+}
+
+size_t snake_env_render(const SnakeEnv *env, uint8_t *pixels, int32_t scale,
+                        int32_t format) {
+  int32_t width, height;
+  size_t size = snake_env_render_size(env, scale, format, &width, &height);
+  if (size == 0) {
+    return 0;
+  }
+
+  SoftTarget target = {
+      .pixels = pixels,
+      .pitch = size / height,
+      .cellScale = scale,
+      .format = format == SNAKE_ENV_FORMAT_RGB ? SOFT_FORMAT_RGB
+                                               : SOFT_FORMAT_GRAY,
+  };
+  render_board_soft(&target, &env->game.state.config, &env->game.snake,
+                    &env->game.foodManager);
+  return size;
+}
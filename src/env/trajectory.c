@@ -0,0 +1,423 @@
+#include "env/trajectory.h"
+#include "utils/memory.h"
+
+#ifndef _WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// 每列初始预分配的字节数，之后按两倍扩展
+#define COLUMN_INITIAL_CAPACITY (64 * 1024)
+// 32位整数的varint最多占5字节
+#define VARINT_MAX_BYTES 5
+
+#define META_FILE "meta.bin"
+#define META_TEMP_FILE "meta.bin.tmp"
+
+static const char *const columnFiles[TRAJECTORY_COLUMN_COUNT] = {
+    "obs_hash.bin", "action.bin", "reward.bin",
+    "score.bin",    "length.bin", "done.bin",
+};
+
+// 元数据文件内容
+typedef struct {
+  uint32_t magic;                                 // TRAJECTORY_MAGIC
+  uint32_t version;                               // TRAJECTORY_VERSION
+  uint64_t rowCount;                              // 行数
+  uint64_t columnBytes[TRAJECTORY_COLUMN_COUNT]; // 各列有效字节数
+} TrajectoryMeta;
+
+// 写入端的一列：文件按capacity预分配并整体映射，used之后的内容全为0
+typedef struct {
+  int fd;              // 文件描述符
+  unsigned char *data; // 映射地址
+  size_t used;         // 已写入的字节数
+  size_t capacity;     // 文件和映射的大小
+} MappedColumn;
+
+struct TrajectoryWriter {
+  char *directory;                               // 数据集目录
+  MappedColumn columns[TRAJECTORY_COLUMN_COUNT]; // 各列
+  uint64_t rowCount;                             // 已写入的行数
+  int32_t lastScore;                             // 上一行的得分（差分基准）
+  int32_t lastLength;                            // 上一行的长度（差分基准）
+};
+
+struct TrajectoryReader {
+  const unsigned char *columns[TRAJECTORY_COLUMN_COUNT]; // 各列映射地址
+  size_t sizes[TRAJECTORY_COLUMN_COUNT];                 // 各列映射大小
+  uint64_t rowCount;                                     // 总行数
+  uint64_t row;                                          // 下一批的起始行
+  size_t scoreOffset;                                    // 得分列读取位置
+  size_t lengthOffset;                                   // 长度列读取位置
+  int32_t score;                                         // 当前得分
+  int32_t length;                                        // 当前长度
+  size_t batchSize;                                      // 每批最多行数
+  int32_t *scores;                                       // 解码缓冲
+  int32_t *lengths;                                      // 解码缓冲
+  uint8_t *actions;                                      // 解码缓冲
+  uint8_t *dones;                                        // 解码缓冲
+};
+
+static bool build_path(char *path, const char *directory, const char *file) {
+  int written = snprintf(path, PATH_MAX, "%s/%s", directory, file);
+  return written > 0 && written < PATH_MAX;
+}
+
+// ---------------- 写入端 ----------------
+
+static bool grow_column(MappedColumn *column, size_t needed) {
+  size_t capacity =
+      column->capacity ? column->capacity : COLUMN_INITIAL_CAPACITY;
+  while (capacity < needed) {
+    capacity *= 2;
+  }
+
+  // ftruncate扩展的部分由内核填0，位压缩列依赖这一点
+  if (ftruncate(column->fd, (off_t)capacity) != 0) {
+    return false;
+  }
+  void *data = mmap(NULL, capacity, PROT_READ | PROT_WRITE, MAP_SHARED,
+                    column->fd, 0);
+  if (data == MAP_FAILED) {
+    return false;
+  }
+  if (column->data != NULL) {
+    munmap(column->data, column->capacity);
+  }
+  column->data = data;
+  column->capacity = capacity;
+  return true;
+}
+
+static inline bool reserve(MappedColumn *column, size_t bytes) {
+  return column->used + bytes <= column->capacity ||
+         grow_column(column, column->used + bytes);
+}
+
+static inline void put_varint(MappedColumn *column, int32_t delta) {
+  // zigzag把小的负数映射为小的无符号数
+  uint32_t value = ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+  unsigned char *out = column->data + column->used;
+  while (value >= 0x80) {
+    *out++ = (unsigned char)(value | 0x80);
+    value >>= 7;
+  }
+  *out++ = (unsigned char)value;
+  column->used = (size_t)(out - column->data);
+}
+
+static bool write_meta(const char *directory, const TrajectoryMeta *meta) {
+  char path[PATH_MAX], temp[PATH_MAX];
+  if (!build_path(path, directory, META_FILE) ||
+      !build_path(temp, directory, META_TEMP_FILE)) {
+    return false;
+  }
+
+  // 先写临时文件再重命名，读取端不会看到写了一半的元数据
+  FILE *file = fopen(temp, "wb");
+  if (file == NULL) {
+    return false;
+  }
+  bool ok = fwrite(meta, sizeof(*meta), 1, file) == 1;
+  ok = fclose(file) == 0 && ok;
+  return ok && rename(temp, path) == 0;
+}
+
+TrajectoryWriter *trajectory_writer_open(const char *directory) {
+  if (directory == NULL || (mkdir(directory, 0755) != 0 && errno != EEXIST)) {
+    return NULL;
+  }
+
+  TrajectoryWriter *writer = NEW_ZEROED(TrajectoryWriter);
+  writer->directory = STRDUP(directory);
+  for (int i = 0; i < TRAJECTORY_COLUMN_COUNT; i++) {
+    writer->columns[i].fd = -1;
+  }
+
+  char path[PATH_MAX];
+  for (int i = 0; i < TRAJECTORY_COLUMN_COUNT; i++) {
+    MappedColumn *column = &writer->columns[i];
+    if (!build_path(path, directory, columnFiles[i])) {
+      goto fail;
+    }
+    column->fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (column->fd < 0 || !grow_column(column, COLUMN_INITIAL_CAPACITY)) {
+      goto fail;
+    }
+  }
+
+  // 空数据集也写出元数据，读取端可以正常打开
+  if (!trajectory_writer_flush(writer)) {
+    goto fail;
+  }
+  return writer;
+
+fail:
+  trajectory_writer_close(writer);
+  return NULL;
+}
+
+bool trajectory_writer_append(TrajectoryWriter *writer,
+                              const TrajectoryStep *step) {
+  MappedColumn *columns = writer->columns;
+  const uint64_t row = writer->rowCount;
+
+  MappedColumn *hash = &columns[TRAJECTORY_COLUMN_OBS_HASH];
+  MappedColumn *reward = &columns[TRAJECTORY_COLUMN_REWARD];
+  MappedColumn *score = &columns[TRAJECTORY_COLUMN_SCORE];
+  MappedColumn *length = &columns[TRAJECTORY_COLUMN_LENGTH];
+  MappedColumn *action = &columns[TRAJECTORY_COLUMN_ACTION];
+  MappedColumn *done = &columns[TRAJECTORY_COLUMN_DONE];
+
+  // 位压缩列只在开始新字节时预留空间
+  if (!reserve(hash, sizeof(uint64_t)) || !reserve(reward, sizeof(float)) ||
+      !reserve(score, VARINT_MAX_BYTES) || !reserve(length, VARINT_MAX_BYTES) ||
+      ((row & 3) == 0 && !reserve(action, 1)) ||
+      ((row & 7) == 0 && !reserve(done, 1))) {
+    return false;
+  }
+
+  memcpy(hash->data + hash->used, &step->obsHash, sizeof(uint64_t));
+  hash->used += sizeof(uint64_t);
+  memcpy(reward->data + reward->used, &step->reward, sizeof(float));
+  reward->used += sizeof(float);
+
+  put_varint(score, step->score - writer->lastScore);
+  put_varint(length, step->length - writer->lastLength);
+  writer->lastScore = step->score;
+  writer->lastLength = step->length;
+
+  if ((row & 3) == 0) {
+    action->used++;
+  }
+  action->data[row >> 2] |=
+      (unsigned char)((step->action & 3) << ((row & 3) * 2));
+  if ((row & 7) == 0) {
+    done->used++;
+  }
+  if (step->done) {
+    done->data[row >> 3] |= (unsigned char)(1 << (row & 7));
+  }
+
+  writer->rowCount = row + 1;
+  return true;
+}
+
+bool trajectory_writer_flush(TrajectoryWriter *writer) {
+  TrajectoryMeta meta = {TRAJECTORY_MAGIC, TRAJECTORY_VERSION,
+                         writer->rowCount, {0}};
+  for (int i = 0; i < TRAJECTORY_COLUMN_COUNT; i++) {
+    meta.columnBytes[i] = writer->columns[i].used;
+  }
+  return write_meta(writer->directory, &meta);
+}
+
+void trajectory_writer_close(TrajectoryWriter *writer) {
+  if (writer == NULL) {
+    return;
+  }
+
+  bool opened = true;
+  for (int i = 0; i < TRAJECTORY_COLUMN_COUNT; i++) {
+    opened = opened && writer->columns[i].data != NULL;
+  }
+  if (opened) {
+    trajectory_writer_flush(writer);
+  }
+
+  // 截掉预分配但未使用的部分
+  for (int i = 0; i < TRAJECTORY_COLUMN_COUNT; i++) {
+    MappedColumn *column = &writer->columns[i];
+    if (column->data != NULL) {
+      munmap(column->data, column->capacity);
+    }
+    if (column->fd >= 0) {
+      if (ftruncate(column->fd, (off_t)column->used) != 0) {
+        perror("截断轨迹列文件失败");
+      }
+      close(column->fd);
+    }
+  }
+  FREE(writer->directory);
+  FREE(writer);
+}
+
+// ---------------- 读取端 ----------------
+
+static bool read_meta(const char *directory, TrajectoryMeta *meta) {
+  char path[PATH_MAX];
+  if (!build_path(path, directory, META_FILE)) {
+    return false;
+  }
+  FILE *file = fopen(path, "rb");
+  if (file == NULL) {
+    return false;
+  }
+  bool ok = fread(meta, sizeof(*meta), 1, file) == 1;
+  fclose(file);
+  return ok && meta->magic == TRAJECTORY_MAGIC &&
+         meta->version == TRAJECTORY_VERSION;
+}
+
+// 映射一列的前size字节（文件可能因仍在写入而更大）
+static const unsigned char *map_column(const char *directory, const char *file,
+                                       size_t size) {
+  char path[PATH_MAX];
+  if (!build_path(path, directory, file)) {
+    return NULL;
+  }
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return NULL;
+  }
+
+  struct stat info;
+  void *data = MAP_FAILED;
+  if (fstat(fd, &info) == 0 && (size_t)info.st_size >= size) {
+    data = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+  return data == MAP_FAILED ? NULL : data;
+}
+
+// 检查各列大小与行数是否一致
+static bool check_sizes(const TrajectoryMeta *meta) {
+  const uint64_t rows = meta->rowCount;
+  const uint64_t *bytes = meta->columnBytes;
+  return bytes[TRAJECTORY_COLUMN_OBS_HASH] == rows * sizeof(uint64_t) &&
+         bytes[TRAJECTORY_COLUMN_REWARD] == rows * sizeof(float) &&
+         bytes[TRAJECTORY_COLUMN_ACTION] == (rows + 3) / 4 &&
+         bytes[TRAJECTORY_COLUMN_DONE] == (rows + 7) / 8 &&
+         bytes[TRAJECTORY_COLUMN_SCORE] >= rows &&
+         bytes[TRAJECTORY_COLUMN_LENGTH] >= rows;
+}
+
+TrajectoryReader *trajectory_reader_open(const char *directory,
+                                         size_t batchSize) {
+  TrajectoryMeta meta;
+  if (directory == NULL || batchSize == 0 || !read_meta(directory, &meta) ||
+      !check_sizes(&meta)) {
+    return NULL;
+  }
+
+  TrajectoryReader *reader = NEW_ZEROED(TrajectoryReader);
+  reader->rowCount = meta.rowCount;
+  for (int i = 0; i < TRAJECTORY_COLUMN_COUNT; i++) {
+    // mmap不接受长度为0的映射，空列保持NULL
+    reader->sizes[i] = (size_t)meta.columnBytes[i];
+    if (reader->sizes[i] == 0) {
+      continue;
+    }
+    reader->columns[i] =
+        map_column(directory, columnFiles[i], reader->sizes[i]);
+    if (reader->columns[i] == NULL) {
+      trajectory_reader_close(reader);
+      return NULL;
+    }
+  }
+
+  reader->batchSize = batchSize;
+  reader->scores = NEW_ARRAY(int32_t, batchSize);
+  reader->lengths = NEW_ARRAY(int32_t, batchSize);
+  reader->actions = NEW_ARRAY(uint8_t, batchSize);
+  reader->dones = NEW_ARRAY(uint8_t, batchSize);
+  return reader;
+}
+
+uint64_t trajectory_reader_rows(const TrajectoryReader *reader) {
+  return reader->rowCount;
+}
+
+// 解码一个varint差分并累加到value上，越界时返回false
+static bool get_varint(const unsigned char *data, size_t size, size_t *offset,
+                       int32_t *value) {
+  uint32_t raw = 0;
+  for (int shift = 0; shift < 7 * VARINT_MAX_BYTES; shift += 7) {
+    if (*offset >= size) {
+      return false;
+    }
+    unsigned char byte = data[(*offset)++];
+    raw |= (uint32_t)(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      *value += (int32_t)((raw >> 1) ^ (0u - (raw & 1)));
+      return true;
+    }
+  }
+  return false;
+}
+
+bool trajectory_reader_next(TrajectoryReader *reader, TrajectoryBatch *batch) {
+  if (reader->row >= reader->rowCount) {
+    return false;
+  }
+
+  const uint64_t first = reader->row;
+  uint64_t remaining = reader->rowCount - first;
+  const size_t count =
+      remaining < reader->batchSize ? (size_t)remaining : reader->batchSize;
+
+  const unsigned char *const *columns = reader->columns;
+  const unsigned char *actionBits = columns[TRAJECTORY_COLUMN_ACTION];
+  const unsigned char *doneBits = columns[TRAJECTORY_COLUMN_DONE];
+  for (size_t i = 0; i < count; i++) {
+    const uint64_t row = first + i;
+    if (!get_varint(columns[TRAJECTORY_COLUMN_SCORE],
+                    reader->sizes[TRAJECTORY_COLUMN_SCORE],
+                    &reader->scoreOffset, &reader->score) ||
+        !get_varint(columns[TRAJECTORY_COLUMN_LENGTH],
+                    reader->sizes[TRAJECTORY_COLUMN_LENGTH],
+                    &reader->lengthOffset, &reader->length)) {
+      return false;
+    }
+    reader->scores[i] = reader->score;
+    reader->lengths[i] = reader->length;
+    reader->actions[i] = (actionBits[row >> 2] >> ((row & 3) * 2)) & 3;
+    reader->dones[i] = (doneBits[row >> 3] >> (row & 7)) & 1;
+  }
+
+  // 定长列直接指向映射内存，不复制
+  batch->count = count;
+  batch->firstRow = first;
+  batch->obsHashes =
+      (const uint64_t *)columns[TRAJECTORY_COLUMN_OBS_HASH] + first;
+  batch->rewards = (const float *)columns[TRAJECTORY_COLUMN_REWARD] + first;
+  batch->scores = reader->scores;
+  batch->lengths = reader->lengths;
+  batch->actions = reader->actions;
+  batch->dones = reader->dones;
+
+  reader->row = first + count;
+  return true;
+}
+
+void trajectory_reader_rewind(TrajectoryReader *reader) {
+  reader->row = 0;
+  reader->scoreOffset = 0;
+  reader->lengthOffset = 0;
+  reader->score = 0;
+  reader->length = 0;
+}
+
+void trajectory_reader_close(TrajectoryReader *reader) {
+  if (reader == NULL) {
+    return;
+  }
+
+  for (int i = 0; i < TRAJECTORY_COLUMN_COUNT; i++) {
+    if (reader->columns[i] != NULL) {
+      munmap((void *)reader->columns[i], reader->sizes[i]);
+    }
+  }
+  FREE(reader->scores);
+  FREE(reader->lengths);
+  FREE(reader->actions);
+  FREE(reader->dones);
+  FREE(reader);
+}
+
+#endif
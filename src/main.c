@@ -18,11 +18,34 @@ static const GameConfig gameConfig = {
     .moveInterval = 0.3f // 150毫秒移动一次
 };
 
+// 在帧边界应用热重载的配置，只包含无需重建窗口或场景即可修改的字段
+static void apply_runtime_config(AppState *state, const RuntimeConfig *config) {
+  SimInput input = {.type = SIM_INPUT_MOVE_INTERVAL,
+                    .moveInterval = config->moveInterval};
+  push_sim_input(&state->sim, input);
+  SDL_GL_SetSwapInterval(config->vsync ? 1 : 0);
+  set_background_effect_type(&state->bgEffect, config->backgroundEffect);
+  set_background_effect_speed(&state->bgEffect, config->backgroundSpeed);
+  set_background_effect_intensity(&state->bgEffect,
+                                  config->backgroundIntensity);
+}
+
 SDL_AppResult SDL_AppInit(void **appstate, int argc, char **argv) {
   // 元数据
   init_app_meta_data();
-  // 分配应用状态
-  AppState *state = NEW(AppState);
+  // SIMD内核的指令集，需在任何内核绑定之前确定
+  init_simd_dispatch();
+  // 分配应用状态（清零）并立即交给SDL，初始化中途失败时由SDL_AppQuit清理
+  AppState *state = NEW_ZEROED(AppState);
+  *appstate = state;
+
+  // 离屏模式不创建窗口，也不启动模拟线程
+  if (is_headless_requested(argc, argv)) {
+    state->headless = NEW_ZEROED(HeadlessApp);
+    return init_headless_app(state->headless, &gameConfig) ? SDL_APP_CONTINUE
+                                                           : SDL_APP_FAILURE;
+  }
+
   // 创建窗口
   if (!create_window(state)) {
     return SDL_APP_FAILURE;
@@ -33,7 +56,7 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char **argv) {
   }
 
   // 初始化游戏场景
-  state->scene = NEW(GameScene);
+  state->scene = NEW_ZEROED(GameScene);
   float white[] = {1.0f, 1.0f, 1.0f, 1.0f}; // RGBA白色
   if (!init_game_scene(state->scene, gameConfig.gridWidth,
                        gameConfig.gridHeight, gameConfig.gridSize, white)) {
@@ -47,28 +70,19 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char **argv) {
     return SDL_APP_FAILURE;
   }
 
-  // 初始化游戏状态
-  init_game_state(&state->gameState, &gameConfig);
-
-  // 初始化贪吃蛇
-  int startX = gameConfig.gridWidth / 2;
-  int startY = gameConfig.gridHeight / 2;
-  init_snake(&state->snake, startX, startY, gameConfig.initialSnakeLength);
-
-  // 初始化食物管理器
-  init_food_manager(&state->foodManager, gameConfig.maxFoodCount);
+  // 初始化游戏并启动模拟线程（从菜单状态开始）
+  if (!start_simulation(&state->sim, &gameConfig)) {
+    return SDL_APP_FAILURE;
+  }
 
-  // 生成初始食物
-  generate_food(&state->foodManager, gameConfig.gridWidth,
-                gameConfig.gridHeight, &state->snake);
+  // 启动配置热重载监视，初始配置在第一帧应用
+  if (!start_config_watcher(&state->configWatcher, WINDOW_CONFIG_PATH)) {
+    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "配置热重载不可用");
+  }
 
   // 记录初始时间
   state->lastFrameTime = SDL_GetTicks();
 
-  // 开始游戏
-  start_game(&state->gameState);
-
-  *appstate = state;
   return SDL_APP_CONTINUE;
 }
 
@@ -77,47 +91,25 @@ SDL_AppResult SDL_AppIterate(void *appstate) {
     return SDL_APP_FAILURE;
   }
   AppState *state = (AppState *)appstate;
+  if (state->headless) {
+    return iterate_headless_app(state->headless) ? SDL_APP_CONTINUE
+                                                 : SDL_APP_SUCCESS;
+  }
+
+  // 应用监视线程发布的新配置（无新配置时只是一次原子交换）
+  const RuntimeConfig *runtimeConfig =
+      poll_config_update(&state->configWatcher);
+  if (runtimeConfig) {
+    apply_runtime_config(state, runtimeConfig);
+  }
 
   // 计算时间增量
   Uint64 currentTime = SDL_GetTicks();
   float deltaTime = (currentTime - state->lastFrameTime) / 1000.0f; // 转换为秒
   state->lastFrameTime = currentTime;
 
-  // 更新游戏状态，检查是否需要移动蛇
-  if (update_game_state(&state->gameState, deltaTime)) {
-    // 先检查是否吃到食物（在移动前检查当前位置）
-    int headX, headY;
-    get_snake_head(&state->snake, &headX, &headY);
-    Food *food = check_food_at_position(&state->foodManager, headX, headY);
-    bool shouldGrow = (food != NULL);
-
-    // 移动蛇，根据是否吃到食物决定是否增长
-    if (!move_snake(&state->snake, state->gameState.currentDirection,
-                    state->gameState.config.gridWidth,
-                    state->gameState.config.gridHeight, shouldGrow)) {
-      // 移动失败，游戏结束
-      game_over(&state->gameState);
-    }
-
-    // 如果吃到食物，处理食物逻辑
-    if (food != NULL) {
-      // 吃到食物，增加分数
-      int foodValue = remove_food(&state->foodManager, food);
-      state->gameState.score += foodValue;
-
-      // 生成新食物
-      generate_food(&state->foodManager, state->gameState.config.gridWidth,
-                    state->gameState.config.gridHeight, &state->snake);
-
-      SDL_Log("吃到食物！当前得分: %d", state->gameState.score);
-    }
-
-    // 检查是否需要生成更多食物
-    if (!is_food_max_reached(&state->foodManager)) {
-      generate_food(&state->foodManager, state->gameState.config.gridWidth,
-                    state->gameState.config.gridHeight, &state->snake);
-    }
-  }
+  // 获取模拟线程发布的最新快照（无锁，不会等待逻辑步进）
+  const GameSnapshot *snapshot = acquire_snapshot(&state->sim);
 
   // 更新背景特效
   update_background_effect(&state->bgEffect, deltaTime);
@@ -134,32 +126,19 @@ SDL_AppResult SDL_AppIterate(void *appstate) {
   // 渲染游戏场景（网格）
   render_game_scene(state->scene);
 
-  // 渲染贪吃蛇（白色）
-  float snakeColor[] = {1.0f, 1.0f, 1.0f, 1.0f}; // RGBA白色
-  KNode *node;
-  knode_for_each(node, &state->snake.head) {
-    SnakeSegment *segment = container_of(node, SnakeSegment, node);
-    float x = segment->x * state->gameState.config.gridSize +
-              state->gameState.config.gridSize / 2.0f;
-    float y = segment->y * state->gameState.config.gridSize +
-              state->gameState.config.gridSize / 2.0f;
-    render_rectangle(&state->scene->gridRenderer, x, y,
-                     state->gameState.config.gridSize * 0.8f,
-                     state->gameState.config.gridSize * 0.8f, snakeColor);
+  // 插值因子：距上次逻辑步进经过的时间占移动间隔的比例，只在游戏中插值
+  float alpha = 1.0f;
+  if (snapshot->state == GAME_STATE_PLAYING && snapshot->moveInterval > 0.0f) {
+    Uint64 now = SDL_GetTicksNS();
+    Uint64 elapsed = now > snapshot->tickTimeNS ? now - snapshot->tickTimeNS : 0;
+    alpha = (elapsed / 1000000000.0f) / snapshot->moveInterval;
+    if (alpha > 1.0f) {
+      alpha = 1.0f;
+    }
   }
 
-  // 渲染食物（红色）
-  float foodColor[] = {1.0f, 0.0f, 0.0f, 1.0f}; // RGBA红色
-  knode_for_each(node, &state->foodManager.head) {
-    Food *food = container_of(node, Food, node);
-    float x = food->x * state->gameState.config.gridSize +
-              state->gameState.config.gridSize / 2.0f;
-    float y = food->y * state->gameState.config.gridSize +
-              state->gameState.config.gridSize / 2.0f;
-    render_rectangle(&state->scene->gridRenderer, x, y,
-                     state->gameState.config.gridSize * 0.6f,
-                     state->gameState.config.gridSize * 0.6f, foodColor);
-  }
+  // 渲染贪吃蛇和食物
+  render_game_snapshot(state->scene, snapshot, alpha);
 
   // 交换缓冲区
   SDL_GL_SwapWindow(state->window);
@@ -167,6 +146,17 @@ SDL_AppResult SDL_AppIterate(void *appstate) {
   return SDL_APP_CONTINUE;
 }
 
+// 输入通过队列交给模拟线程，在其下一步处理
+static void send_direction(AppState *state, Direction direction) {
+  SimInput input = {.type = SIM_INPUT_DIRECTION, .direction = direction};
+  push_sim_input(&state->sim, input);
+}
+
+static void send_command(AppState *state, GameCommand command) {
+  SimInput input = {.type = SIM_INPUT_COMMAND, .command = command};
+  push_sim_input(&state->sim, input);
+}
+
 SDL_AppResult SDL_AppEvent(void *appstate, SDL_Event *event) {
   if (!appstate) {
     return SDL_APP_FAILURE;
@@ -182,44 +172,27 @@ SDL_AppResult SDL_AppEvent(void *appstate, SDL_Event *event) {
     switch (event->key.scancode) {
     case SDL_SCANCODE_UP:
     case SDL_SCANCODE_W:
-      change_direction(&state->gameState, DIRECTION_UP);
+      send_direction(state, DIRECTION_UP);
       break;
     case SDL_SCANCODE_DOWN:
     case SDL_SCANCODE_S:
-      change_direction(&state->gameState, DIRECTION_DOWN);
+      send_direction(state, DIRECTION_DOWN);
       break;
     case SDL_SCANCODE_LEFT:
     case SDL_SCANCODE_A:
-      change_direction(&state->gameState, DIRECTION_LEFT);
+      send_direction(state, DIRECTION_LEFT);
       break;
     case SDL_SCANCODE_RIGHT:
     case SDL_SCANCODE_D:
-      change_direction(&state->gameState, DIRECTION_RIGHT);
+      send_direction(state, DIRECTION_RIGHT);
       break;
     case SDL_SCANCODE_SPACE:
-      if (state->gameState.currentState == GAME_STATE_PLAYING) {
-        pause_game(&state->gameState);
-      } else if (state->gameState.currentState == GAME_STATE_PAUSED) {
-        resume_game(&state->gameState);
-      }
+    case SDL_SCANCODE_RETURN:
+      // 开始/暂停/继续由状态机根据当前状态决定
+      send_command(state, GAME_COMMAND_ACTION);
       break;
     case SDL_SCANCODE_R:
-      if (state->gameState.currentState == GAME_STATE_GAME_OVER) {
-        reset_game(&state->gameState);
-        // 重新初始化蛇和食物
-        cleanup_snake(&state->snake);
-        cleanup_food_manager(&state->foodManager);
-
-        int startX = state->gameState.config.gridWidth / 2;
-        int startY = state->gameState.config.gridHeight / 2;
-        init_snake(&state->snake, startX, startY,
-                   state->gameState.config.initialSnakeLength);
-        init_food_manager(&state->foodManager,
-                          state->gameState.config.maxFoodCount);
-        generate_food(&state->foodManager, state->gameState.config.gridWidth,
-                      state->gameState.config.gridHeight, &state->snake);
-        start_game(&state->gameState);
-      }
+      send_command(state, GAME_COMMAND_RESTART);
       break;
     case SDL_SCANCODE_ESCAPE:
       return SDL_APP_SUCCESS;
@@ -235,6 +208,15 @@ void SDL_AppQuit(void *appstate, SDL_AppResult result) {
   if (appstate) {
     AppState *state = (AppState *)appstate;
 
+    // 离屏模式：取回剩余的帧并输出总帧率
+    if (state->headless) {
+      cleanup_headless_app(state->headless);
+      FREE(state->headless);
+    }
+
+    // 停止配置监视线程
+    stop_config_watcher(&state->configWatcher);
+
     // 清理游戏场景
     if (state->scene) {
       cleanup_game_scene(state->scene);
@@ -244,10 +226,12 @@ void SDL_AppQuit(void *appstate, SDL_AppResult result) {
     // 清理背景特效管理器
     cleanup_background_effect(&state->bgEffect);
 
-    // 清理贪吃蛇和食物管理器
-    cleanup_snake(&state->snake);
-    cleanup_food_manager(&state->foodManager);
+    // 停止模拟线程并清理游戏（贪吃蛇和食物管理器）
+    stop_simulation(&state->sim);
 
+    if (state->glContext) {
+      SDL_GL_DestroyContext(state->glContext);
+    }
     SDL_DestroyWindow(state->window);
     FREE(state);
   }
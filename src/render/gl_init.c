@@ -9,6 +9,7 @@ int init_opengl_render(AppState *state) {
                  SDL_GetError());
     return 0;
   }
+  state->glContext = gl_context;
   // 使当前线程的OpenGL上下文成为当前上下文
   SDL_GL_MakeCurrent(state->window, gl_context);
   // 启用垂直同步
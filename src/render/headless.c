@@ -0,0 +1,311 @@
+#include "render/headless.h"
+#include <SDL3/SDL.h>
+#include <string.h>
+
+#ifdef SNAKE_HEADLESS_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+// 与world_to_gl_coords中的游戏区域边长一致，使棋盘恰好铺满帧缓冲
+#define HEADLESS_VIRTUAL_SCREEN 600
+// 等待回读完成的最长时间（纳秒）
+#define HEADLESS_WAIT_TIMEOUT_NS 1000000000ULL
+
+static bool has_extension(const char *extensions, const char *name) {
+  if (extensions == NULL) {
+    return false;
+  }
+  size_t length = strlen(name);
+  for (const char *p = strstr(extensions, name); p != NULL;
+       p = strstr(p + length, name)) {
+    if ((p == extensions || p[-1] == ' ') &&
+        (p[length] == ' ' || p[length] == '\0')) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// 优先使用Mesa的surfaceless平台，不依赖任何窗口系统
+static EGLDisplay open_display(void) {
+  const char *clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+  if (has_extension(clientExtensions, "EGL_MESA_platform_surfaceless")) {
+    PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+        (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress(
+            "eglGetPlatformDisplayEXT");
+    if (getPlatformDisplay) {
+      EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA,
+                                              EGL_DEFAULT_DISPLAY, NULL);
+      if (display != EGL_NO_DISPLAY) {
+        return display;
+      }
+    }
+  }
+  return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+static int create_context(HeadlessRenderer *renderer) {
+  EGLDisplay display = open_display();
+  if (display == EGL_NO_DISPLAY || !eglInitialize(display, NULL, NULL)) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "EGL初始化失败");
+    return 0;
+  }
+  renderer->display = display;
+
+  const EGLint configAttribs[] = {EGL_SURFACE_TYPE,
+                                  EGL_PBUFFER_BIT,
+                                  EGL_RENDERABLE_TYPE,
+                                  EGL_OPENGL_BIT,
+                                  EGL_RED_SIZE,
+                                  8,
+                                  EGL_GREEN_SIZE,
+                                  8,
+                                  EGL_BLUE_SIZE,
+                                  8,
+                                  EGL_ALPHA_SIZE,
+                                  8,
+                                  EGL_NONE};
+  EGLConfig config;
+  EGLint configCount = 0;
+  if (!eglChooseConfig(display, configAttribs, &config, 1, &configCount) ||
+      configCount == 0 || !eglBindAPI(EGL_OPENGL_API)) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "没有可用的EGL配置");
+    return 0;
+  }
+
+  const EGLint contextAttribs[] = {EGL_CONTEXT_MAJOR_VERSION,
+                                   3,
+                                   EGL_CONTEXT_MINOR_VERSION,
+                                   3,
+                                   EGL_CONTEXT_OPENGL_PROFILE_MASK,
+                                   EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+                                   EGL_NONE};
+  EGLContext context =
+      eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+  if (context == EGL_NO_CONTEXT) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "EGL上下文创建失败: 0x%x",
+                 eglGetError());
+    return 0;
+  }
+  renderer->context = context;
+
+  // 不支持无表面上下文时创建一个1x1的pbuffer，实际渲染目标始终是FBO
+  EGLSurface surface = EGL_NO_SURFACE;
+  if (!has_extension(eglQueryString(display, EGL_EXTENSIONS),
+                     "EGL_KHR_surfaceless_context")) {
+    const EGLint pbufferAttribs[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE};
+    surface = eglCreatePbufferSurface(display, config, pbufferAttribs);
+    if (surface == EGL_NO_SURFACE) {
+      SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "pbuffer创建失败: 0x%x",
+                   eglGetError());
+      return 0;
+    }
+  }
+  renderer->surface = surface;
+
+  if (!eglMakeCurrent(display, surface, surface, context)) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "EGL上下文激活失败: 0x%x",
+                 eglGetError());
+    return 0;
+  }
+
+  if (!gladLoadGLLoader((GLADloadproc)eglGetProcAddress)) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "GLAD初始化失败");
+    return 0;
+  }
+  return 1;
+}
+
+static int create_framebuffer(HeadlessRenderer *renderer) {
+  glGenRenderbuffers(1, &renderer->colorBuffer);
+  glBindRenderbuffer(GL_RENDERBUFFER, renderer->colorBuffer);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, renderer->width,
+                        renderer->height);
+
+  glGenFramebuffers(1, &renderer->framebuffer);
+  glBindFramebuffer(GL_FRAMEBUFFER, renderer->framebuffer);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                            GL_RENDERBUFFER, renderer->colorBuffer);
+  if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "离屏帧缓冲不完整");
+    return 0;
+  }
+
+  // 预分配回读环，GL_STREAM_READ提示驱动把缓冲放在CPU可读的内存中
+  glGenBuffers(HEADLESS_PBO_COUNT, renderer->pixelBuffers);
+  for (int i = 0; i < HEADLESS_PBO_COUNT; i++) {
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, renderer->pixelBuffers[i]);
+    glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)renderer->frameSize, NULL,
+                 GL_STREAM_READ);
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  // RGB每行字节数不一定是4的倍数
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  return 1;
+}
+
+int init_headless_renderer(HeadlessRenderer *renderer, int width, int height,
+                           HeadlessPixelFormat format,
+                           const GameConfig *config) {
+  memset(renderer, 0, sizeof(*renderer));
+  renderer->width = width;
+  renderer->height = height;
+  renderer->format = format;
+  renderer->frameSize = (size_t)width * height *
+                        (format == HEADLESS_FORMAT_RGB ? 3 : 4);
+
+  if (!create_context(renderer) || !create_framebuffer(renderer)) {
+    cleanup_headless_renderer(renderer);
+    return 0;
+  }
+
+  float white[] = {1.0f, 1.0f, 1.0f, 1.0f}; // RGBA白色
+  if (!init_game_scene_with_screen(&renderer->scene, config->gridWidth,
+                                   config->gridHeight, config->gridSize, white,
+                                   HEADLESS_VIRTUAL_SCREEN,
+                                   HEADLESS_VIRTUAL_SCREEN)) {
+    cleanup_headless_renderer(renderer);
+    return 0;
+  }
+  return 1;
+}
+
+uint64_t submit_headless_frame(HeadlessRenderer *renderer,
+                               const GameSnapshot *snapshot) {
+  if (renderer->pending == HEADLESS_PBO_COUNT) {
+    return 0;
+  }
+
+  // 观测帧不需要动态背景，只绘制边界、蛇和食物
+  glBindFramebuffer(GL_FRAMEBUFFER, renderer->framebuffer);
+  glViewport(0, 0, renderer->width, renderer->height);
+  glDisable(GL_DEPTH_TEST);
+  glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+  glClear(GL_COLOR_BUFFER_BIT);
+  render_game_scene(&renderer->scene);
+  render_game_snapshot(&renderer->scene, snapshot, 1.0f);
+
+  // 回读到PBO只是排队一条GPU命令，立即返回
+  int slot = renderer->head;
+  GLenum format = renderer->format == HEADLESS_FORMAT_RGB ? GL_RGB : GL_RGBA;
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, renderer->pixelBuffers[slot]);
+  glReadPixels(0, 0, renderer->width, renderer->height, format,
+               GL_UNSIGNED_BYTE, (void *)0);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  renderer->fences[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  glFlush();
+
+  renderer->frameIds[slot] = ++renderer->nextFrameId;
+  renderer->head = (slot + 1) % HEADLESS_PBO_COUNT;
+  renderer->pending++;
+  return renderer->frameIds[slot];
+}
+
+int read_headless_frame(HeadlessRenderer *renderer, unsigned char *pixels,
+                        uint64_t *frameId, bool wait) {
+  if (renderer->pending == 0) {
+    return 0;
+  }
+
+  int slot = (renderer->head - renderer->pending + HEADLESS_PBO_COUNT) %
+             HEADLESS_PBO_COUNT;
+  GLenum result = glClientWaitSync(renderer->fences[slot],
+                                   wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0,
+                                   wait ? HEADLESS_WAIT_TIMEOUT_NS : 0);
+  if (result == GL_TIMEOUT_EXPIRED || result == GL_WAIT_FAILED) {
+    return 0;
+  }
+  glDeleteSync(renderer->fences[slot]);
+  renderer->fences[slot] = NULL;
+
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, renderer->pixelBuffers[slot]);
+  const unsigned char *data = (const unsigned char *)glMapBufferRange(
+      GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr)renderer->frameSize,
+      GL_MAP_READ_BIT);
+  if (data != NULL) {
+    // OpenGL的第0行在底部，翻转为自上而下
+    size_t stride = renderer->frameSize / renderer->height;
+    for (int row = 0; row < renderer->height; row++) {
+      memcpy(pixels + row * stride,
+             data + (renderer->height - 1 - row) * stride, stride);
+    }
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  if (frameId != NULL) {
+    *frameId = renderer->frameIds[slot];
+  }
+  renderer->pending--;
+  return data != NULL;
+}
+
+void cleanup_headless_renderer(HeadlessRenderer *renderer) {
+  if (renderer->context != NULL) {
+    for (int i = 0; i < HEADLESS_PBO_COUNT; i++) {
+      if (renderer->fences[i] != NULL) {
+        glDeleteSync(renderer->fences[i]);
+      }
+    }
+    if (renderer->pixelBuffers[0] != 0) {
+      glDeleteBuffers(HEADLESS_PBO_COUNT, renderer->pixelBuffers);
+    }
+    if (renderer->framebuffer != 0) {
+      glDeleteFramebuffers(1, &renderer->framebuffer);
+    }
+    if (renderer->colorBuffer != 0) {
+      glDeleteRenderbuffers(1, &renderer->colorBuffer);
+    }
+    if (renderer->scene.gridRenderer.shaderProgram != 0) {
+      cleanup_game_scene(&renderer->scene);
+    }
+  }
+
+  if (renderer->display != NULL) {
+    eglMakeCurrent(renderer->display, EGL_NO_SURFACE, EGL_NO_SURFACE,
+                   EGL_NO_CONTEXT);
+    if (renderer->surface != NULL) {
+      eglDestroySurface(renderer->display, renderer->surface);
+    }
+    if (renderer->context != NULL) {
+      eglDestroyContext(renderer->display, renderer->context);
+    }
+    eglTerminate(renderer->display);
+  }
+  memset(renderer, 0, sizeof(*renderer));
+}
+
+#else
+
+int init_headless_renderer(HeadlessRenderer *renderer, int width, int height,
+                           HeadlessPixelFormat format,
+                           const GameConfig *config) {
+  (void)width;
+  (void)height;
+  (void)format;
+  (void)config;
+  memset(renderer, 0, sizeof(*renderer));
+  SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "当前构建不支持离屏渲染（需要EGL）");
+  return 0;
+}
+
+uint64_t submit_headless_frame(HeadlessRenderer *renderer,
+                               const GameSnapshot *snapshot) {
+  (void)renderer;
+  (void)snapshot;
+  return 0;
+}
+
+int read_headless_frame(HeadlessRenderer *renderer, unsigned char *pixels,
+                        uint64_t *frameId, bool wait) {
+  (void)renderer;
+  (void)pixels;
+  (void)frameId;
+  (void)wait;
+  return 0;
+}
+
+void cleanup_headless_renderer(HeadlessRenderer *renderer) { (void)renderer; }
+
+#endif
@@ -0,0 +1,170 @@
+#include "render/soft_renderer.h"
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SOFT_USE_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define SOFT_USE_NEON
+#endif
+
+// 尺寸比例与render_game_scene/render_game_snapshot一致
+#define SOFT_BORDER_RATIO 0.05f // 包围线宽0.1格且居中于边缘，棋盘内只有一半
+#define SOFT_SNAKE_RATIO 0.8f
+#define SOFT_FOOD_RATIO 0.6f
+
+typedef struct {
+  unsigned char r;
+  unsigned char g;
+  unsigned char b;
+} SoftColor;
+
+static const SoftColor borderColor = {255, 255, 255}; // 白色
+static const SoftColor snakeColor = {255, 255, 255};  // 白色
+static const SoftColor foodColor = {255, 0, 0};       // 红色
+
+// BT.601亮度，定点计算
+static unsigned char luminance(SoftColor color) {
+  return (unsigned char)((color.r * 77 + color.g * 150 + color.b * 29) >> 8);
+}
+
+static int bytes_per_pixel(SoftPixelFormat format) {
+  return format == SOFT_FORMAT_RGB ? 3 : 1;
+}
+
+// 用同一颜色填充一段RGB像素，每次写入16个像素（48字节）
+static void fill_span_rgb(unsigned char *dst, int count, SoftColor color) {
+#if defined(SOFT_USE_SSE2)
+  if (count >= 16) {
+    const char r = (char)color.r, g = (char)color.g, b = (char)color.b;
+    const __m128i p0 =
+        _mm_setr_epi8(r, g, b, r, g, b, r, g, b, r, g, b, r, g, b, r);
+    const __m128i p1 =
+        _mm_setr_epi8(g, b, r, g, b, r, g, b, r, g, b, r, g, b, r, g);
+    const __m128i p2 =
+        _mm_setr_epi8(b, r, g, b, r, g, b, r, g, b, r, g, b, r, g, b);
+    for (; count >= 16; count -= 16, dst += 48) {
+      _mm_storeu_si128((__m128i *)dst, p0);
+      _mm_storeu_si128((__m128i *)(dst + 16), p1);
+      _mm_storeu_si128((__m128i *)(dst + 32), p2);
+    }
+  }
+#elif defined(SOFT_USE_NEON)
+  if (count >= 16) {
+    uint8x16x3_t pattern;
+    pattern.val[0] = vdupq_n_u8(color.r);
+    pattern.val[1] = vdupq_n_u8(color.g);
+    pattern.val[2] = vdupq_n_u8(color.b);
+    for (; count >= 16; count -= 16, dst += 48) {
+      vst3q_u8(dst, pattern);
+    }
+  }
+#endif
+  for (; count > 0; count--, dst += 3) {
+    dst[0] = color.r;
+    dst[1] = color.g;
+    dst[2] = color.b;
+  }
+}
+
+// 填充矩形：只填充第一行，其余各行直接复制
+static void fill_rect(const SoftTarget *target, int x, int y, int width,
+                      int height, SoftColor color) {
+  if (width <= 0 || height <= 0) {
+    return;
+  }
+
+  const int bpp = bytes_per_pixel(target->format);
+  unsigned char *first = target->pixels + (size_t)y * target->pitch +
+                         (size_t)x * bpp;
+  if (target->format == SOFT_FORMAT_RGB) {
+    fill_span_rgb(first, width, color);
+  } else {
+    memset(first, luminance(color), (size_t)width);
+  }
+
+  unsigned char *row = first;
+  for (int i = 1; i < height; i++) {
+    row += target->pitch;
+    memcpy(row, first, (size_t)width * bpp);
+  }
+}
+
+// 绘制居中于格子的方块，ratio为方块边长与格子边长之比
+static void fill_cell(const SoftTarget *target, const GameConfig *config,
+                      int cellX, int cellY, float ratio, SoftColor color) {
+  if (cellX < 0 || cellX >= config->gridWidth || cellY < 0 ||
+      cellY >= config->gridHeight) {
+    return;
+  }
+
+  const int scale = target->cellScale;
+  int inset = (int)(scale * (1.0f - ratio) / 2.0f + 0.5f);
+  if (scale - 2 * inset <= 0) {
+    inset = (scale - 1) / 2; // 格子太小时至少保留一个像素
+  }
+  const int size = scale - 2 * inset;
+  fill_rect(target, cellX * scale + inset, cellY * scale + inset, size, size,
+            color);
+}
+
+// 清屏并绘制包围线
+static void draw_background(const SoftTarget *target,
+                            const GameConfig *config) {
+  int width, height;
+  soft_target_size(config, target->cellScale, &width, &height);
+  const size_t rowBytes = (size_t)width * bytes_per_pixel(target->format);
+
+  unsigned char *row = target->pixels;
+  for (int y = 0; y < height; y++, row += target->pitch) {
+    memset(row, 0, rowBytes); // 黑色背景
+  }
+
+  int border = (int)(target->cellScale * SOFT_BORDER_RATIO + 0.5f);
+  if (border < 1) {
+    border = 1;
+  }
+  fill_rect(target, 0, 0, width, border, borderColor);               // 上边界
+  fill_rect(target, 0, height - border, width, border, borderColor); // 下边界
+  fill_rect(target, 0, 0, border, height, borderColor);              // 左边界
+  fill_rect(target, width - border, 0, border, height, borderColor); // 右边界
+}
+
+void soft_target_size(const GameConfig *config, int cellScale, int *width,
+                      int *height) {
+  *width = config->gridWidth * cellScale;
+  *height = config->gridHeight * cellScale;
+}
+
+void render_board_soft(const SoftTarget *target, const GameConfig *config,
+                       const Snake *snake, const FoodManager *foodManager) {
+  draw_background(target, config);
+
+  const KNode *node;
+  knode_for_each(node, &snake->head) {
+    const SnakeSegment *segment = container_of(node, SnakeSegment, node);
+    fill_cell(target, config, segment->x, segment->y, SOFT_SNAKE_RATIO,
+              snakeColor);
+  }
+
+  knode_for_each(node, &foodManager->head) {
+    const Food *food = container_of(node, Food, node);
+    fill_cell(target, config, food->x, food->y, SOFT_FOOD_RATIO, foodColor);
+  }
+}
+
+void render_snapshot_soft(const SoftTarget *target, const GameConfig *config,
+                          const GameSnapshot *snapshot) {
+  draw_background(target, config);
+
+  for (int i = 0; i < snapshot->snakeLength; i++) {
+    fill_cell(target, config, snapshot->snakeCells[i].x,
+              snapshot->snakeCells[i].y, SOFT_SNAKE_RATIO, snakeColor);
+  }
+
+  for (int i = 0; i < snapshot->foodCount; i++) {
+    fill_cell(target, config, snapshot->foodCells[i].x,
+              snapshot->foodCells[i].y, SOFT_FOOD_RATIO, foodColor);
+  }
+}
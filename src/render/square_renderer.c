@@ -17,6 +17,12 @@ int init_square_renderer(SquareRenderer *renderer,
     return 0;
   }
 
+  // 缓存uniform位置，避免每次绘制都查询
+  renderer->colorLocation =
+      glGetUniformLocation(renderer->shaderProgram, "color");
+  renderer->transformLocation =
+      glGetUniformLocation(renderer->shaderProgram, "transform");
+
   // 创建顶点数据（一个单位方格）
   float vertices[] = {
       // 位置坐标     // 纹理坐标
@@ -80,18 +86,13 @@ void render_rectangle(SquareRenderer *renderer, float worldX, float worldY,
                    &glHeight);
 
   // 设置颜色uniform
-  GLint colorLocation = glGetUniformLocation(renderer->shaderProgram, "color");
-  glUniform4f(colorLocation, color[0], color[1], color[2], color[3]);
-
-  // 设置变换uniform
-  GLint transformLocation =
-      glGetUniformLocation(renderer->shaderProgram, "transform");
+  glUniform4f(renderer->colorLocation, color[0], color[1], color[2], color[3]);
 
   // 创建变换矩阵（先缩放后平移）
   float transform[16] = {glWidth, 0.0f, 0.0f, 0.0f, 0.0f, glHeight, 0.0f, 0.0f,
                          0.0f,    0.0f, 1.0f, 0.0f, glX,  glY,      0.0f, 1.0f};
 
-  glUniformMatrix4fv(transformLocation, 1, GL_FALSE, transform);
+  glUniformMatrix4fv(renderer->transformLocation, 1, GL_FALSE, transform);
 
   // 渲染矩形
   glBindVertexArray(renderer->VAO);
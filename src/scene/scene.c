@@ -7,6 +7,14 @@
 
 int init_game_scene(GameScene *scene, int gridWidth, int gridHeight,
                     float gridSize, float gridColor[4]) {
+  return init_game_scene_with_screen(scene, gridWidth, gridHeight, gridSize,
+                                     gridColor, SCREEN_WIDTH, SCREEN_HEIGHT);
+}
+
+int init_game_scene_with_screen(GameScene *scene, int gridWidth,
+                                int gridHeight, float gridSize,
+                                float gridColor[4], int screenWidth,
+                                int screenHeight) {
   // 设置场景参数
   scene->gridWidth = gridWidth;
   scene->gridHeight = gridHeight;
@@ -21,8 +29,8 @@ int init_game_scene(GameScene *scene, int gridWidth, int gridHeight,
   // 游戏世界坐标范围：从0到网格尺寸
   float worldWidth = gridWidth * gridSize;
   float worldHeight = gridHeight * gridSize;
-  scene->coord =
-      init_coordinate_system(0, worldWidth, 0, worldHeight, SCREEN_WIDTH, SCREEN_HEIGHT);
+  scene->coord = init_coordinate_system(0, worldWidth, 0, worldHeight,
+                                        screenWidth, screenHeight);
 
   // 初始化网格渲染器
   if (!init_square_renderer(&scene->gridRenderer, &scene->coord,
@@ -59,6 +67,31 @@ void render_game_scene(GameScene *scene) {
                    borderWidth, worldHeight, scene->gridColor);
 }
 
+void render_game_snapshot(GameScene *scene, const GameSnapshot *snapshot,
+                          float alpha) {
+  const float gridSize = scene->gridSize;
+
+  // 渲染贪吃蛇（白色），位置在上一步与当前步之间插值
+  float snakeColor[] = {1.0f, 1.0f, 1.0f, 1.0f}; // RGBA白色
+  for (int i = 0; i < snapshot->snakeLength; i++) {
+    float cellX, cellY;
+    interpolate_snake_cell(snapshot, i, alpha, &cellX, &cellY);
+    float x = cellX * gridSize + gridSize / 2.0f;
+    float y = cellY * gridSize + gridSize / 2.0f;
+    render_rectangle(&scene->gridRenderer, x, y, gridSize * 0.8f,
+                     gridSize * 0.8f, snakeColor);
+  }
+
+  // 渲染食物（红色）
+  float foodColor[] = {1.0f, 0.0f, 0.0f, 1.0f}; // RGBA红色
+  for (int i = 0; i < snapshot->foodCount; i++) {
+    float x = snapshot->foodCells[i].x * gridSize + gridSize / 2.0f;
+    float y = snapshot->foodCells[i].y * gridSize + gridSize / 2.0f;
+    render_rectangle(&scene->gridRenderer, x, y, gridSize * 0.6f,
+                     gridSize * 0.6f, foodColor);
+  }
+}
+
 void cleanup_game_scene(GameScene *scene) {
   cleanup_square_renderer(&scene->gridRenderer);
 }
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include "utils/fsm.h"
+#include <stddef.h>
+
+void FSM_Init(FSM *fsm, const State *initialState, FSMContext context) {
+  if (fsm == NULL) {
+    return;
+  }
+
+  fsm->currentState = initialState;
+  fsm->previousState = NULL;
+  fsm->context = context;
+  fsm->isRunning = false;
+}
+
+void FSM_Update(FSM *fsm, float deltaTime) {
+  if (fsm == NULL || !fsm->isRunning || fsm->currentState == NULL) {
+    return;
+  }
+
+  // 按表中顺序检查转换条件，第一个满足的转换生效（每次更新最多转换一次）
+  const State *state = fsm->currentState;
+  for (uint8_t i = 0; i < state->transitionCount; i++) {
+    const Transition *transition = &state->transitions[i];
+    if (transition->condition == NULL ||
+        transition->condition(fsm, fsm->context)) {
+      FSM_ChangeState(fsm, transition->targetState);
+      break;
+    }
+  }
+
+  // 更新（可能刚进入的）当前状态
+  if (fsm->currentState->update != NULL) {
+    fsm->currentState->update(fsm, fsm->context, deltaTime);
+  }
+}
+
+void FSM_ChangeState(FSM *fsm, const State *newState) {
+  if (fsm == NULL || newState == NULL) {
+    return;
+  }
+
+  if (fsm->isRunning && fsm->currentState != NULL &&
+      fsm->currentState->exit != NULL) {
+    fsm->currentState->exit(fsm, fsm->context);
+  }
+
+  fsm->previousState = fsm->currentState;
+  fsm->currentState = newState;
+
+  if (fsm->isRunning && newState->enter != NULL) {
+    newState->enter(fsm, fsm->context);
+  }
+}
+
+const State *FSM_GetCurrentState(const FSM *fsm) {
+  return fsm ? fsm->currentState : NULL;
+}
+
+const State *FSM_GetPreviousState(const FSM *fsm) {
+  return fsm ? fsm->previousState : NULL;
+}
+
+const char *FSM_GetCurrentStateName(const FSM *fsm) {
+  if (fsm == NULL || fsm->currentState == NULL) {
+    return "";
+  }
+  return fsm->currentState->name;
+}
+
+void FSM_Start(FSM *fsm) {
+  if (fsm == NULL || fsm->isRunning) {
+    return;
+  }
+
+  fsm->isRunning = true;
+  if (fsm->currentState != NULL && fsm->currentState->enter != NULL) {
+    fsm->currentState->enter(fsm, fsm->context);
+  }
+}
+
+void FSM_Stop(FSM *fsm) {
+  if (fsm == NULL || !fsm->isRunning) {
+    return;
+  }
+
+  if (fsm->currentState != NULL && fsm->currentState->exit != NULL) {
+    fsm->currentState->exit(fsm, fsm->context);
+  }
+  fsm->isRunning = false;
+}
+
+bool FSM_IsRunning(const FSM *fsm) { return fsm != NULL && fsm->isRunning; }
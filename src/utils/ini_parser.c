@@ -5,20 +5,43 @@
 #include <string.h>
 #include <ctype.h>
 #include <errno.h>
+#include <stdint.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #define INITIAL_SECTION_CAPACITY 8
 #define INITIAL_ENTRY_CAPACITY 16
-#define MAX_LINE_LENGTH 1024
+#define INITIAL_INDEX_CAPACITY 16
+#define NO_SECTION ((size_t)-1)
+
+// 文件只读视图（POSIX下为mmap映射，其他平台为整体读入的缓冲区）
+typedef struct {
+    const char* data;
+    size_t size;
+} file_view_t;
 
 // 内部函数声明
-static ini_section_t* find_or_create_section(ini_file_t* ini, const char* section_name);
+static ini_section_t* find_or_create_section(ini_file_t* ini, const char* section_name, bool copy);
 static ini_section_t* find_section(const ini_file_t* ini, const char* section_name);
 static ini_entry_t* find_entry(const ini_section_t* section, const char* key);
-static char* trim_string(char* str);
-static bool parse_line(char* line, char** section, char** key, char** value);
-static bool is_comment_line(const char* line);
-static bool is_section_line(const char* line);
-static char* extract_section_name(char* line);
+static bool section_set_value(ini_file_t* ini, ini_section_t* section, char* key, char* value, bool copy);
+static bool parse_buffer(ini_file_t* ini, const char* data, size_t size);
+static bool parse_span(ini_file_t* ini, const char* start, const char* end, size_t* current, size_t* used);
+static char* arena_store(ini_file_t* ini, const char* start, const char* end, size_t* used);
+static void release_string(const ini_file_t* ini, char* str);
+static bool map_file(const char* filename, file_view_t* view);
+static void unmap_file(file_view_t* view);
+static size_t hash_string(const char* str);
+static size_t* index_alloc(size_t count, size_t* capacity);
+static void index_put(size_t* slots, size_t capacity, size_t hash, size_t position);
+static bool rebuild_section_index(ini_file_t* ini);
+static bool rebuild_entry_index(ini_section_t* section);
+static void trim_span(const char** start, const char** end);
 static char* strdup_safe(const char* str);
 
 ini_file_t* ini_create(void) {
@@ -33,6 +56,10 @@ ini_file_t* ini_create(void) {
     
     ini->section_count = 0;
     ini->section_capacity = INITIAL_SECTION_CAPACITY;
+    ini->section_index = NULL;
+    ini->index_capacity = 0;
+    ini->arena = NULL;
+    ini->arena_size = 0;
     
     return ini;
 }
@@ -40,56 +67,16 @@ ini_file_t* ini_create(void) {
 ini_file_t* ini_load(const char* filename) {
     if (!filename) return NULL;
     
-    FILE* file = fopen(filename, "r");
-    if (!file) return NULL;
+    file_view_t view;
+    if (!map_file(filename, &view)) return NULL;
     
     ini_file_t* ini = ini_create();
-    if (!ini) {
-        fclose(file);
-        return NULL;
-    }
-    
-    char line[MAX_LINE_LENGTH];
-    char* current_section = NULL;
-    
-    while (fgets(line, sizeof(line), file)) {
-        char* trimmed_line = trim_string(line);
-        if (!trimmed_line[0]) continue; // 跳过空行
-        
-        if (is_comment_line(trimmed_line)) continue; // 跳过注释行
-        
-        if (is_section_line(trimmed_line)) {
-            current_section = extract_section_name(trimmed_line);
-            if (!current_section) continue;
-            
-            // 创建或找到对应的节
-            ini_section_t* section = find_or_create_section(ini, current_section);
-            if (!section) {
-                free(current_section);
-                fclose(file);
-                ini_free(ini);
-                return NULL;
-            }
-            continue;
-        }
-        
-        // 解析键值对
-        char* key = NULL;
-        char* value = NULL;
-        char* section_name = current_section ? current_section : "";
-        
-        if (parse_line(trimmed_line, &section_name, &key, &value)) {
-            ini_section_t* section = find_or_create_section(ini, section_name);
-            if (section && key && value) {
-                ini_set_string(ini, section_name, key, value);
-            }
-            free(key);
-            free(value);
-        }
+    if (ini && !parse_buffer(ini, view.data, view.size)) {
+        ini_free(ini);
+        ini = NULL;
     }
     
-    if (current_section) free(current_section);
-    fclose(file);
+    unmap_file(&view);
     return ini;
 }
 
@@ -99,71 +86,11 @@ ini_file_t* ini_load_from_string(const char* data) {
     ini_file_t* ini = ini_create();
     if (!ini) return NULL;
     
-    char* copy = strdup_safe(data);
-    if (!copy) {
+    if (!parse_buffer(ini, data, strlen(data))) {
         ini_free(ini);
         return NULL;
     }
     
-    char* current_section = NULL;
-    char* line = copy;
-    char* next_line;
-    
-    while (line && *line) {
-        // 找到下一行
-        next_line = strchr(line, '\n');
-        if (next_line) {
-            *next_line = '\0';
-            next_line++;
-        }
-        
-        char* trimmed_line = trim_string(line);
-        if (!trimmed_line[0]) {
-            line = next_line;
-            continue; // 跳过空行
-        }
-        
-        if (is_comment_line(trimmed_line)) {
-            line = next_line;
-            continue; // 跳过注释行
-        }
-        
-        if (is_section_line(trimmed_line)) {
-            if (current_section) free(current_section);
-            current_section = extract_section_name(trimmed_line);
-            
-            if (current_section) {
-                ini_section_t* section = find_or_create_section(ini, current_section);
-                if (!section) {
-                    free(current_section);
-                    free(copy);
-                    ini_free(ini);
-                    return NULL;
-                }
-            }
-            line = next_line;
-            continue;
-        }
-        
-        // 解析键值对
-        char* key = NULL;
-        char* value = NULL;
-        char* section_name = current_section ? current_section : "";
-        
-        if (parse_line(trimmed_line, &section_name, &key, &value)) {
-            ini_section_t* section = find_or_create_section(ini, section_name);
-            if (section && key && value) {
-                ini_set_string(ini, section_name, key, value);
-            }
-            free(key);
-            free(value);
-        }
-        
-        line = next_line;
-    }
-    
-    if (current_section) free(current_section);
-    free(copy);
     return ini;
 }
 
@@ -201,19 +128,23 @@ bool ini_save(const ini_file_t* ini, const char* filename) {
 void ini_free(ini_file_t* ini) {
     if (!ini) return;
     
+    // 加载得到的字符串都位于arena中，只需释放之后通过ini_set_*写入的部分
     for (size_t i = 0; i < ini->section_count; i++) {
         ini_section_t* section = &ini->sections[i];
-        if (section->name) free(section->name);
+        release_string(ini, section->name);
         
         for (size_t j = 0; j < section->entry_count; j++) {
-            if (section->entries[j].key) free(section->entries[j].key);
-            if (section->entries[j].value) free(section->entries[j].value);
+            release_string(ini, section->entries[j].key);
+            release_string(ini, section->entries[j].value);
         }
         
         if (section->entries) free(section->entries);
+        if (section->entry_index) free(section->entry_index);
     }
     
     if (ini->sections) free(ini->sections);
+    if (ini->section_index) free(ini->section_index);
+    if (ini->arena) free(ini->arena);
     free(ini);
 }
 
@@ -274,32 +205,10 @@ bool ini_set_string(ini_file_t* ini, const char* section, const char* key, const
     if (!ini || !key || !value) return false;
     
     const char* section_name = section ? section : "";
-    ini_section_t* sec = find_or_create_section(ini, section_name);
+    ini_section_t* sec = find_or_create_section(ini, section_name, true);
     if (!sec) return false;
     
-    ini_entry_t* entry = find_entry(sec, key);
-    if (entry) {
-        // 更新现有值
-        free(entry->value);
-        entry->value = strdup_safe(value);
-        return entry->value != NULL;
-    }
-    
-    // 添加新条目
-    if (sec->entry_count >= sec->entry_capacity) {
-        size_t new_capacity = sec->entry_capacity * 2;
-        ini_entry_t* new_entries = (ini_entry_t*)realloc(sec->entries, sizeof(ini_entry_t) * new_capacity);
-        if (!new_entries) return false;
-        
-        sec->entries = new_entries;
-        sec->entry_capacity = new_capacity;
-    }
-    
-    ini_entry_t* new_entry = &sec->entries[sec->entry_count++];
-    new_entry->key = strdup_safe(key);
-    new_entry->value = strdup_safe(value);
-    
-    return new_entry->key != NULL && new_entry->value != NULL;
+    return section_set_value(ini, sec, (char*)key, (char*)value, true);
 }
 
 bool ini_set_int(ini_file_t* ini, const char* section, const char* key, int value) {
@@ -325,48 +234,52 @@ bool ini_delete_key(ini_file_t* ini, const char* section, const char* key) {
     ini_section_t* sec = find_section(ini, section_name);
     if (!sec) return false;
     
-    for (size_t i = 0; i < sec->entry_count; i++) {
-        if (strcmp(sec->entries[i].key, key) == 0) {
-            free(sec->entries[i].key);
-            free(sec->entries[i].value);
-            
-            // 移动后续条目
-            for (size_t j = i; j < sec->entry_count - 1; j++) {
-                sec->entries[j] = sec->entries[j + 1];
-            }
-            
-            sec->entry_count--;
-            return true;
-        }
+    ini_entry_t* entry = find_entry(sec, key);
+    if (!entry) return false;
+    
+    size_t i = (size_t)(entry - sec->entries);
+    release_string(ini, entry->key);
+    release_string(ini, entry->value);
+    
+    // 移动后续条目
+    for (size_t j = i; j < sec->entry_count - 1; j++) {
+        sec->entries[j] = sec->entries[j + 1];
     }
     
-    return false;
+    sec->entry_count--;
+    
+    // 条目下标已变化，重建键索引
+    rebuild_entry_index(sec);
+    return true;
 }
 
 bool ini_delete_section(ini_file_t* ini, const char* section) {
     if (!ini || !section) return false;
     
-    for (size_t i = 0; i < ini->section_count; i++) {
-        if (strcmp(ini->sections[i].name, section) == 0) {
-            // 释放节内存
-            free(ini->sections[i].name);
-            for (size_t j = 0; j < ini->sections[i].entry_count; j++) {
-                free(ini->sections[i].entries[j].key);
-                free(ini->sections[i].entries[j].value);
-            }
-            free(ini->sections[i].entries);
-            
-            // 移动后续节
-            for (size_t j = i; j < ini->section_count - 1; j++) {
-                ini->sections[j] = ini->sections[j + 1];
-            }
-            
-            ini->section_count--;
-            return true;
-        }
+    ini_section_t* sec = find_section(ini, section);
+    if (!sec) return false;
+    
+    size_t i = (size_t)(sec - ini->sections);
+    
+    // 释放节内存
+    release_string(ini, sec->name);
+    for (size_t j = 0; j < sec->entry_count; j++) {
+        release_string(ini, sec->entries[j].key);
+        release_string(ini, sec->entries[j].value);
+    }
+    free(sec->entries);
+    free(sec->entry_index);
+    
+    // 移动后续节
+    for (size_t j = i; j < ini->section_count - 1; j++) {
+        ini->sections[j] = ini->sections[j + 1];
     }
     
-    return false;
+    ini->section_count--;
+    
+    // 节下标已变化，重建节索引
+    rebuild_section_index(ini);
+    return true;
 }
 
 bool ini_has_section(const ini_file_t* ini, const char* section) {
@@ -423,7 +336,7 @@ size_t ini_get_keys(const ini_file_t* ini, const char* section, char** keys, siz
 
 // 内部函数实现
 
-static ini_section_t* find_or_create_section(ini_file_t* ini, const char* section_name) {
+static ini_section_t* find_or_create_section(ini_file_t* ini, const char* section_name, bool copy) {
     ini_section_t* section = find_section(ini, section_name);
     if (section) return section;
     
@@ -438,15 +351,28 @@ static ini_section_t* find_or_create_section(ini_file_t* ini, const char* sectio
     }
     
     ini_section_t* new_section = &ini->sections[ini->section_count++];
-    new_section->name = strdup_safe(section_name);
+    new_section->name = copy ? strdup_safe(section_name) : (char*)section_name;
+    new_section->hash = hash_string(section_name);
     new_section->entries = (ini_entry_t*)malloc(sizeof(ini_entry_t) * INITIAL_ENTRY_CAPACITY);
     new_section->entry_count = 0;
     new_section->entry_capacity = INITIAL_ENTRY_CAPACITY;
+    new_section->entry_index = NULL;
+    new_section->index_capacity = 0;
+    
+    // 负载因子超过1/2时扩容重建，否则直接插入索引
+    bool indexed;
+    if (ini->section_count * 2 > ini->index_capacity) {
+        indexed = rebuild_section_index(ini);
+    } else {
+        index_put(ini->section_index, ini->index_capacity, new_section->hash, ini->section_count - 1);
+        indexed = true;
+    }
     
-    if (!new_section->name || !new_section->entries) {
-        if (new_section->name) free(new_section->name);
+    if (!new_section->name || !new_section->entries || !indexed) {
+        if (copy && new_section->name) free(new_section->name);
         if (new_section->entries) free(new_section->entries);
         ini->section_count--;
+        if (indexed) rebuild_section_index(ini);
         return NULL;
     }
     
@@ -454,11 +380,16 @@ static ini_section_t* find_or_create_section(ini_file_t* ini, const char* sectio
 }
 
 static ini_section_t* find_section(const ini_file_t* ini, const char* section_name) {
-    if (!ini || !section_name) return NULL;
+    if (!ini || !section_name || !ini->section_index) return NULL;
     
-    for (size_t i = 0; i < ini->section_count; i++) {
-        if (strcmp(ini->sections[i].name, section_name) == 0) {
-            return (ini_section_t*)&ini->sections[i];
+    size_t hash = hash_string(section_name);
+    size_t mask = ini->index_capacity - 1;
+    
+    // 线性探测，直到遇到空槽
+    for (size_t i = hash & mask; ini->section_index[i]; i = (i + 1) & mask) {
+        ini_section_t* section = &ini->sections[ini->section_index[i] - 1];
+        if (section->hash == hash && strcmp(section->name, section_name) == 0) {
+            return section;
         }
     }
     
@@ -466,67 +397,287 @@ static ini_section_t* find_section(const ini_file_t* ini, const char* section_na
 }
 
 static ini_entry_t* find_entry(const ini_section_t* section, const char* key) {
-    if (!section || !key) return NULL;
+    if (!section || !key || !section->entry_index) return NULL;
     
-    for (size_t i = 0; i < section->entry_count; i++) {
-        if (strcmp(section->entries[i].key, key) == 0) {
-            return (ini_entry_t*)&section->entries[i];
+    size_t hash = hash_string(key);
+    size_t mask = section->index_capacity - 1;
+    
+    // 线性探测，直到遇到空槽
+    for (size_t i = hash & mask; section->entry_index[i]; i = (i + 1) & mask) {
+        ini_entry_t* entry = &section->entries[section->entry_index[i] - 1];
+        if (entry->hash == hash && strcmp(entry->key, key) == 0) {
+            return entry;
         }
     }
     
     return NULL;
 }
 
-static char* trim_string(char* str) {
-    if (!str) return NULL;
+static bool section_set_value(ini_file_t* ini, ini_section_t* section, char* key, char* value, bool copy) {
+    ini_entry_t* entry = find_entry(section, key);
+    if (entry) {
+        // 更新现有值
+        char* new_value = copy ? strdup_safe(value) : value;
+        if (!new_value) return false;
+        
+        release_string(ini, entry->value);
+        entry->value = new_value;
+        return true;
+    }
     
-    // 去除前导空白
-    char* start = str;
-    while (isspace((unsigned char)*start)) start++;
+    // 添加新条目
+    if (section->entry_count >= section->entry_capacity) {
+        size_t new_capacity = section->entry_capacity * 2;
+        ini_entry_t* new_entries = (ini_entry_t*)realloc(section->entries, sizeof(ini_entry_t) * new_capacity);
+        if (!new_entries) return false;
+        
+        section->entries = new_entries;
+        section->entry_capacity = new_capacity;
+    }
     
-    // 去除尾部空白
-    char* end = start + strlen(start) - 1;
-    while (end > start && isspace((unsigned char)*end)) end--;
+    ini_entry_t* new_entry = &section->entries[section->entry_count++];
+    new_entry->key = copy ? strdup_safe(key) : key;
+    new_entry->value = copy ? strdup_safe(value) : value;
+    new_entry->hash = hash_string(key);
     
-    *(end + 1) = '\0';
-    return start;
+    if (!new_entry->key || !new_entry->value) {
+        release_string(ini, new_entry->key);
+        release_string(ini, new_entry->value);
+        section->entry_count--;
+        return false;
+    }
+    
+    // 负载因子超过1/2时扩容重建，否则直接插入索引
+    if (section->entry_count * 2 > section->index_capacity) {
+        if (!rebuild_entry_index(section)) {
+            release_string(ini, new_entry->key);
+            release_string(ini, new_entry->value);
+            section->entry_count--;
+            return false;
+        }
+    } else {
+        index_put(section->entry_index, section->index_capacity, new_entry->hash, section->entry_count - 1);
+    }
+    
+    return true;
+}
+
+static bool parse_buffer(ini_file_t* ini, const char* data, size_t size) {
+    // 每行至少消耗一个分隔符（换行或'='），因此所有字符串连同结尾'\0'
+    // 最多占用 size + 1 字节，一次分配即可容纳
+    ini->arena = (char*)malloc(size + 1);
+    if (!ini->arena) return false;
+    ini->arena_size = size + 1;
+    
+    size_t current = NO_SECTION;
+    size_t used = 0;
+    const char* line = data;
+    const char* end = data + size;
+    
+    while (line < end) {
+        // memchr由C库以SIMD实现，长行不需要逐字节扫描
+        const char* next_line = (const char*)memchr(line, '\n', (size_t)(end - line));
+        const char* line_end = next_line ? next_line : end;
+        
+        if (!parse_span(ini, line, line_end, &current, &used)) return false;
+        
+        line = next_line ? next_line + 1 : end;
+    }
+    
+    return true;
 }
 
-static bool parse_line(char* line, char** section, char** key, char** value) {
-    if (!line || !key || !value) return false;
+static bool parse_span(ini_file_t* ini, const char* start, const char* end, size_t* current, size_t* used) {
+    trim_span(&start, &end);
+    if (start == end) return true; // 跳过空行
     
-    char* equal_sign = strchr(line, '=');
-    if (!equal_sign) return false;
+    if (*start == ';' || *start == '#') return true; // 跳过注释行
     
-    *equal_sign = '\0';
+    if (*start == '[' && end[-1] == ']') {
+        if (end - start < 3) return true; // 至少需要 [x]
+        
+        const char* name_start = start + 1;
+        const char* name_end = end - 1;
+        trim_span(&name_start, &name_end);
+        
+        // 创建或找到对应的节，记录下标供后续键值对直接使用
+        char* section_name = arena_store(ini, name_start, name_end, used);
+        ini_section_t* section = find_or_create_section(ini, section_name, false);
+        if (!section) return false;
+        
+        *current = (size_t)(section - ini->sections);
+        return true;
+    }
     
-    *key = trim_string(line);
-    *value = trim_string(equal_sign + 1);
+    // 解析键值对
+    const char* equal_sign = (const char*)memchr(start, '=', (size_t)(end - start));
+    if (!equal_sign) return true;
+    
+    const char* key_start = start;
+    const char* key_end = equal_sign;
+    const char* value_start = equal_sign + 1;
+    const char* value_end = end;
+    trim_span(&key_start, &key_end);
+    trim_span(&value_start, &value_end);
+    if (key_start == key_end) return true;
+    
+    // 节之前的键值对归入无名节
+    if (*current == NO_SECTION) {
+        ini_section_t* section = find_or_create_section(ini, "", true);
+        if (!section) return false;
+        
+        *current = (size_t)(section - ini->sections);
+    }
     
-    if (!*key || !**key) return false;
+    char* key = arena_store(ini, key_start, key_end, used);
+    char* value = arena_store(ini, value_start, value_end, used);
+    return section_set_value(ini, &ini->sections[*current], key, value, false);
+}
+
+static char* arena_store(ini_file_t* ini, const char* start, const char* end, size_t* used) {
+    size_t length = (size_t)(end - start);
+    char* str = ini->arena + *used;
+    memcpy(str, start, length);
+    str[length] = '\0';
+    *used += length + 1;
+    return str;
+}
+
+static void release_string(const ini_file_t* ini, char* str) {
+    if (!str) return;
     
-    *key = strdup_safe(*key);
-    *value = strdup_safe(*value);
+    // arena中的字符串随ini_free整体释放
+    if (ini->arena && str >= ini->arena && str < ini->arena + ini->arena_size) return;
     
-    return *key != NULL && *value != NULL;
+    free(str);
 }
 
-static bool is_comment_line(const char* line) {
-    if (!line) return false;
-    return line[0] == ';' || line[0] == '#';
+static bool map_file(const char* filename, file_view_t* view) {
+#ifndef _WIN32
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) return false;
+    
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return false;
+    }
+    
+    view->size = (size_t)st.st_size;
+    view->data = "";
+    
+    // 空文件无法映射，直接视为空内容
+    if (view->size > 0) {
+        void* data = mmap(NULL, view->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            close(fd);
+            return false;
+        }
+        
+        madvise(data, view->size, MADV_SEQUENTIAL);
+        view->data = (const char*)data;
+    }
+    
+    close(fd);
+    return true;
+#else
+    FILE* file = fopen(filename, "rb");
+    if (!file) return false;
+    
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size < 0) {
+        fclose(file);
+        return false;
+    }
+    
+    char* data = (char*)malloc((size_t)size + 1);
+    if (!data) {
+        fclose(file);
+        return false;
+    }
+    
+    view->size = fread(data, 1, (size_t)size, file);
+    view->data = data;
+    fclose(file);
+    return true;
+#endif
 }
 
-static bool is_section_line(const char* line) {
-    if (!line) return false;
-    return line[0] == '[' && line[strlen(line) - 1] == ']';
+static void unmap_file(file_view_t* view) {
+#ifndef _WIN32
+    if (view->size > 0) munmap((void*)view->data, view->size);
+#else
+    free((void*)view->data);
+#endif
+    view->data = NULL;
+    view->size = 0;
+}
+
+static size_t hash_string(const char* str) {
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    while (*str) {
+        hash ^= (unsigned char)*str++;
+        hash *= 1099511628211ULL;
+    }
+    return (size_t)hash;
 }
 
-static char* extract_section_name(char* line) {
-    if (!line || strlen(line) < 3) return NULL; // 至少需要 [x]
+static size_t* index_alloc(size_t count, size_t* capacity) {
+    // 保证负载因子不超过1/2，探测一定能遇到空槽
+    size_t new_capacity = INITIAL_INDEX_CAPACITY;
+    while (new_capacity < count * 2) new_capacity <<= 1;
     
-    line[strlen(line) - 1] = '\0'; // 去除尾部']'
-    char* name = trim_string(line + 1); // 跳过头部'['
-    return strdup_safe(name);
+    size_t* slots = (size_t*)calloc(new_capacity, sizeof(size_t));
+    if (slots) *capacity = new_capacity;
+    return slots;
+}
+
+static void index_put(size_t* slots, size_t capacity, size_t hash, size_t position) {
+    size_t mask = capacity - 1;
+    size_t i = hash & mask;
+    while (slots[i]) i = (i + 1) & mask;
+    slots[i] = position + 1;
+}
+
+static bool rebuild_section_index(ini_file_t* ini) {
+    size_t capacity;
+    size_t* slots = index_alloc(ini->section_count, &capacity);
+    if (!slots) return false;
+    
+    for (size_t i = 0; i < ini->section_count; i++) {
+        index_put(slots, capacity, ini->sections[i].hash, i);
+    }
+    
+    free(ini->section_index);
+    ini->section_index = slots;
+    ini->index_capacity = capacity;
+    return true;
+}
+
+static bool rebuild_entry_index(ini_section_t* section) {
+    size_t capacity;
+    size_t* slots = index_alloc(section->entry_count, &capacity);
+    if (!slots) return false;
+    
+    for (size_t i = 0; i < section->entry_count; i++) {
+        index_put(slots, capacity, section->entries[i].hash, i);
+    }
+    
+    free(section->entry_index);
+    section->entry_index = slots;
+    section->index_capacity = capacity;
+    return true;
+}
+
+static void trim_span(const char** start, const char** end) {
+    // 去除前导空白
+    while (*start < *end && isspace((unsigned char)**start)) (*start)++;
+    
+    // 去除尾部空白
+    while (*end > *start && isspace((unsigned char)(*end)[-1])) (*end)--;
 }
 
 static char* strdup_safe(const char* str) {
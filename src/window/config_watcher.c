@@ -0,0 +1,204 @@
+#include "window/config_watcher.h"
+#include "utils/ini_parser.h"
+#include "utils/memory.h"
+#include <string.h>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+// 监视线程检查退出标志的间隔（毫秒）
+#define WATCH_POLL_INTERVAL_MS 250
+
+// 背景特效名称，与BackgroundEffectType一一对应
+static const char *effectNames[BACKGROUND_EFFECT_COUNT] = {
+    "wave", "gradient", "pulse", "warm_random"};
+
+static BackgroundEffectType parse_effect_type(const char *name) {
+  for (int i = 0; i < BACKGROUND_EFFECT_COUNT; i++) {
+    if (strcmp(name, effectNames[i]) == 0) {
+      return (BackgroundEffectType)i;
+    }
+  }
+  return BACKGROUND_EFFECT_WARM_RANDOM;
+}
+
+RuntimeConfig *load_runtime_config(const char *path) {
+  ini_file_t *ini = ini_load(path);
+  if (!ini) {
+    return NULL;
+  }
+
+  RuntimeConfig *config = NEW(RuntimeConfig);
+  config->moveInterval =
+      (float)ini_get_double(ini, "game", "move_interval", 0.3);
+  config->vsync = ini_get_bool(ini, "window", "vsync", true);
+  config->backgroundEffect = parse_effect_type(
+      ini_get_string(ini, "background", "effect", "warm_random"));
+  config->backgroundSpeed =
+      (float)ini_get_double(ini, "background", "speed", 1.0);
+  config->backgroundIntensity =
+      (float)ini_get_double(ini, "background", "intensity", 1.0);
+
+  // 过小的移动间隔会让蛇瞬间撞墙，视为无效配置
+  if (config->moveInterval < 0.01f) {
+    config->moveInterval = 0.01f;
+  }
+
+  ini_free(ini);
+  return config;
+}
+
+// 发布新快照：原子交换待应用指针，未被取走的旧快照由发布方释放
+static void publish_config(ConfigWatcher *watcher, RuntimeConfig *config) {
+  RuntimeConfig *stale =
+      (RuntimeConfig *)SDL_SetAtomicPointer(&watcher->pending, config);
+  if (stale) {
+    FREE(stale);
+  }
+}
+
+static void reload_config(ConfigWatcher *watcher) {
+  RuntimeConfig *config = load_runtime_config(watcher->path);
+  if (!config) {
+    // 编辑器可能正在写入，保留当前配置等待下一次变更
+    SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "重新加载配置失败: %s",
+                watcher->path);
+    return;
+  }
+  publish_config(watcher, config);
+  SDL_Log("配置已重新加载: %s", watcher->path);
+}
+
+#ifdef __linux__
+static int watch_thread(void *data) {
+  ConfigWatcher *watcher = (ConfigWatcher *)data;
+
+  // 监视所在目录而不是文件本身，编辑器保存时常以重命名替换文件
+  char *dir = STRDUP(watcher->path);
+  char *slash = strrchr(dir, '/');
+  const char *base = watcher->path;
+  if (slash) {
+    *slash = '\0';
+    base = slash + 1;
+  } else {
+    strcpy(dir, ".");
+  }
+
+  int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (fd < 0 ||
+      inotify_add_watch(fd, dir, IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "无法监视配置目录: %s", dir);
+    if (fd >= 0) {
+      close(fd);
+    }
+    FREE(dir);
+    return 0;
+  }
+
+  char buffer[4096]
+      __attribute__((aligned(__alignof__(struct inotify_event))));
+  while (SDL_GetAtomicInt(&watcher->running)) {
+    struct pollfd pfd = {.fd = fd, .events = POLLIN};
+    if (poll(&pfd, 1, WATCH_POLL_INTERVAL_MS) <= 0) {
+      continue;
+    }
+
+    // 一次读取可能包含多个事件，合并为一次重新加载
+    bool changed = false;
+    ssize_t length;
+    while ((length = read(fd, buffer, sizeof(buffer))) > 0) {
+      for (char *ptr = buffer; ptr < buffer + length;) {
+        const struct inotify_event *event = (const struct inotify_event *)ptr;
+        if (event->len > 0 && strcmp(event->name, base) == 0) {
+          changed = true;
+        }
+        ptr += sizeof(struct inotify_event) + event->len;
+      }
+    }
+
+    if (changed) {
+      reload_config(watcher);
+    }
+  }
+
+  close(fd);
+  FREE(dir);
+  return 0;
+}
+#else
+// 没有inotify的平台退化为轮询文件修改时间
+static int watch_thread(void *data) {
+  ConfigWatcher *watcher = (ConfigWatcher *)data;
+
+  struct stat st;
+  time_t lastModified = stat(watcher->path, &st) == 0 ? st.st_mtime : 0;
+  while (SDL_GetAtomicInt(&watcher->running)) {
+    SDL_Delay(WATCH_POLL_INTERVAL_MS);
+    if (stat(watcher->path, &st) == 0 && st.st_mtime != lastModified) {
+      lastModified = st.st_mtime;
+      reload_config(watcher);
+    }
+  }
+  return 0;
+}
+#endif
+
+int start_config_watcher(ConfigWatcher *watcher, const char *path) {
+  watcher->path = STRDUP(path);
+  watcher->pending = NULL;
+  watcher->current = NULL;
+  SDL_SetAtomicInt(&watcher->running, 1);
+
+  // 初始快照在第一帧应用
+  RuntimeConfig *config = load_runtime_config(path);
+  if (config) {
+    publish_config(watcher, config);
+  }
+
+  watcher->thread = SDL_CreateThread(watch_thread, "config-watcher", watcher);
+  if (!watcher->thread) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "创建配置监视线程失败: %s",
+                 SDL_GetError());
+    return 0;
+  }
+  return 1;
+}
+
+const RuntimeConfig *poll_config_update(ConfigWatcher *watcher) {
+  // 取走快照后它归渲染线程所有，监视线程不会再访问
+  RuntimeConfig *config =
+      (RuntimeConfig *)SDL_SetAtomicPointer(&watcher->pending, NULL);
+  if (!config) {
+    return NULL;
+  }
+
+  if (watcher->current) {
+    FREE(watcher->current);
+  }
+  watcher->current = config;
+  return config;
+}
+
+void stop_config_watcher(ConfigWatcher *watcher) {
+  SDL_SetAtomicInt(&watcher->running, 0);
+  if (watcher->thread) {
+    SDL_WaitThread(watcher->thread, NULL);
+    watcher->thread = NULL;
+  }
+
+  RuntimeConfig *pending =
+      (RuntimeConfig *)SDL_SetAtomicPointer(&watcher->pending, NULL);
+  if (pending) {
+    FREE(pending);
+  }
+  if (watcher->current) {
+    FREE(watcher->current);
+  }
+  if (watcher->path) {
+    FREE(watcher->path);
+  }
+}
@@ -0,0 +1,163 @@
+#include "window/headless_app.h"
+#include "utils/ini_parser.h"
+#include "utils/memory.h"
+#include "window/window.h"
+#include <string.h>
+
+// 观测帧的默认分辨率（与常见的Atari预处理一致）
+#define HEADLESS_DEFAULT_SIZE 84
+// 输出帧率的间隔（纳秒）
+#define HEADLESS_REPORT_NS 1000000000ULL
+
+bool is_headless_requested(int argc, char **argv) {
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], HEADLESS_APP_FLAG) == 0) {
+      return true;
+    }
+  }
+
+  ini_file_t *ini = ini_load(WINDOW_CONFIG_PATH);
+  if (!ini) {
+    return false;
+  }
+  bool enabled = ini_get_bool(ini, "headless", "enabled", false);
+  ini_free(ini);
+  return enabled;
+}
+
+// 开始新的一局：重建棋盘，直接进入游戏中状态
+static void begin_round(HeadlessApp *app) {
+  reset_game_board(&app->game);
+  start_game(&app->game.state);
+}
+
+// 推进一步：沿最短路径走向最近的食物，找不到路径时保持方向
+static void advance_game(HeadlessApp *app) {
+  Game *game = &app->game;
+  if (find_nearest_food_path(&app->finder, &game->snake,
+                             &game->foodManager) > 0) {
+    Direction move;
+    get_path_moves(&app->finder, &move, 1);
+    change_direction(&game->state, move);
+  }
+  if (!step_game(game)) {
+    begin_round(app);
+  }
+}
+
+// 取回最早提交的一帧并写入输出文件，返回是否取回
+static bool collect_frame(HeadlessApp *app, bool wait) {
+  if (!read_headless_frame(&app->renderer, app->pixels, NULL, wait)) {
+    return false;
+  }
+  if (app->output) {
+    fwrite(app->pixels, 1, app->renderer.frameSize, app->output);
+  }
+  app->completed++;
+  return true;
+}
+
+int init_headless_app(HeadlessApp *app, const GameConfig *config) {
+  int width = HEADLESS_DEFAULT_SIZE;
+  int height = HEADLESS_DEFAULT_SIZE;
+  HeadlessPixelFormat format = HEADLESS_FORMAT_RGB;
+
+  // 输出路径在ini_free后失效，先打开文件
+  ini_file_t *ini = ini_load(WINDOW_CONFIG_PATH);
+  if (ini) {
+    width = ini_get_int(ini, "headless", "width", width);
+    height = ini_get_int(ini, "headless", "height", height);
+    if (strcmp(ini_get_string(ini, "headless", "format", "rgb"), "rgba") ==
+        0) {
+      format = HEADLESS_FORMAT_RGBA;
+    }
+    int frames = ini_get_int(ini, "headless", "frames", 0);
+    app->frameLimit = frames > 0 ? (uint64_t)frames : 0;
+    const char *outputPath = ini_get_string(ini, "headless", "output", "");
+    if (outputPath[0] != '\0') {
+      app->output = fopen(outputPath, "wb");
+      if (!app->output) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "无法打开帧输出文件: %s",
+                     outputPath);
+        ini_free(ini);
+        return 0;
+      }
+    }
+    ini_free(ini);
+  }
+
+  // 不需要视频子系统，事件子系统用于响应Ctrl+C退出
+  if (!SDL_Init(SDL_INIT_EVENTS)) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL初始化失败: %s",
+                 SDL_GetError());
+    return 0;
+  }
+  if (!init_headless_renderer(&app->renderer, width, height, format,
+                              config)) {
+    return 0;
+  }
+  app->pixels = NEW_ARRAY(unsigned char, app->renderer.frameSize);
+
+  init_game(&app->game, config);
+  init_path_finder(&app->finder, config->gridWidth, config->gridHeight,
+                   GRID_LAYOUT_ROW_MAJOR);
+  init_game_snapshot(&app->snapshot, config);
+  begin_round(app);
+
+  SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "离屏模式: %dx%d %s",
+              width, height, format == HEADLESS_FORMAT_RGB ? "RGB" : "RGBA");
+  app->startTimeNS = SDL_GetTicksNS();
+  app->reportTimeNS = app->startTimeNS;
+  return 1;
+}
+
+bool iterate_headless_app(HeadlessApp *app) {
+  for (int i = 0; i < HEADLESS_APP_BATCH; i++) {
+    if (app->frameLimit > 0 && app->submitted >= app->frameLimit) {
+      return false;
+    }
+
+    // 回读环已满时等待最早的一帧，其余时候只取已完成的帧
+    if (app->renderer.pending == HEADLESS_PBO_COUNT) {
+      collect_frame(app, true);
+    }
+    advance_game(app);
+    fill_game_snapshot(&app->snapshot, &app->game);
+    submit_headless_frame(&app->renderer, &app->snapshot);
+    app->submitted++;
+    while (collect_frame(app, false)) {
+    }
+  }
+
+  Uint64 now = SDL_GetTicksNS();
+  if (now - app->reportTimeNS >= HEADLESS_REPORT_NS) {
+    double seconds = (now - app->reportTimeNS) / 1e9;
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "离屏帧率: %.0f fps",
+                (app->completed - app->reportFrames) / seconds);
+    app->reportTimeNS = now;
+    app->reportFrames = app->completed;
+  }
+  return true;
+}
+
+void cleanup_headless_app(HeadlessApp *app) {
+  if (app->pixels) {
+    while (collect_frame(app, true)) {
+    }
+    double seconds = (SDL_GetTicksNS() - app->startTimeNS) / 1e9;
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION,
+                "离屏模式结束: %llu帧，平均%.0f fps",
+                (unsigned long long)app->completed,
+                seconds > 0 ? app->completed / seconds : 0.0);
+
+    cleanup_game_snapshot(&app->snapshot);
+    cleanup_path_finder(&app->finder);
+    cleanup_game(&app->game);
+    FREE(app->pixels);
+  }
+  cleanup_headless_renderer(&app->renderer);
+  if (app->output) {
+    fclose(app->output);
+    app->output = NULL;
+  }
+}
@@ -1,4 +1,5 @@
 #include "window/window.h"
+#include "core/cpu_dispatch.h"
 #include "utils/ini_parser.h"
 #include <SDL3/SDL.h>
 #include <stdio.h>
@@ -6,7 +7,7 @@
 
 int init_app_meta_data() {
   // 加载INI配置文件
-  ini_file_t *ini = ini_load("assets/config/windows.ini");
+  ini_file_t *ini = ini_load(WINDOW_CONFIG_PATH);
   if (!ini) {
     // 如果无法加载INI文件，使用默认值
     SDL_SetAppMetadataProperty(SDL_PROP_APP_METADATA_NAME_STRING,
@@ -50,9 +51,18 @@ int init_app_meta_data() {
   return 0;
 }
 
+void init_simd_dispatch() {
+  ini_file_t *ini = ini_load(WINDOW_CONFIG_PATH);
+  // 配置文件的字符串在ini_free后失效，init_cpu_dispatch不保留它
+  init_cpu_dispatch(ini ? ini_get_string(ini, "debug", "simd", "auto")
+                        : NULL);
+  if (ini)
+    ini_free(ini);
+}
+
 int create_window(AppState *state) {
   // 加载INI配置文件
-  ini_file_t *ini = ini_load("assets/config/windows.ini");
+  ini_file_t *ini = ini_load(WINDOW_CONFIG_PATH);
   if (!ini) {
     SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
                  "无法加载窗口配置文件，使用默认设置");